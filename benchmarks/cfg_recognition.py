@@ -0,0 +1,65 @@
+"""
+Compares the recognition of long words by the CYK algorithm and by the
+algorithm of Valiant
+
+Usage: python3 benchmarks/cfg_recognition.py [--max-cyk-length N] [LENGTH...]
+"""
+
+import argparse
+import random
+import time
+
+from pyformlang.cfg import CFG
+
+# Balanced parentheses, with a and b as parentheses
+GRAMMAR = """
+    S -> S S | a S b | a b
+"""
+
+
+def get_balanced_word(length: int, rng: random.Random):
+    """ A random word of balanced parentheses """
+    word = []
+    depth = 0
+    while len(word) < length:
+        if depth and (rng.random() < 0.5 or len(word) + depth >= length):
+            word.append("b")
+            depth -= 1
+        else:
+            word.append("a")
+            depth += 1
+    return word
+
+
+def get_time(function, *arguments, **keywords):
+    """ The result of a call and the seconds it takes """
+    start = time.perf_counter()
+    result = function(*arguments, **keywords)
+    return result, time.perf_counter() - start
+
+
+def main():
+    """ Runs the benchmark """
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("lengths", type=int, nargs="*",
+                        default=[100, 200, 500, 1000, 2000, 5000])
+    parser.add_argument("--max-cyk-length", type=int, default=1000,
+                        help="the longest word given to the CYK algorithm")
+    arguments = parser.parse_args()
+    compiled_cfg = CFG.from_text(GRAMMAR).compile()
+    rng = random.Random(42)
+    print("length   cyk (s)   valiant (s)")
+    for length in arguments.lengths:
+        word = get_balanced_word(length, rng)
+        valiant, valiant_time = get_time(compiled_cfg.contains, word,
+                                         method="valiant")
+        cyk_text = "-"
+        if length <= arguments.max_cyk_length:
+            cyk, cyk_time = get_time(compiled_cfg.contains, word)
+            assert cyk == valiant
+            cyk_text = f"{cyk_time:.3f}"
+        print(f"{length:6d}   {cyk_text:>7}   {valiant_time:11.3f}")
+
+
+if __name__ == "__main__":
+    main()
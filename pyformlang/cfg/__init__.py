@@ -17,6 +17,12 @@ Terminal
     A context-free grammar terminal
 Epsilon
     The epsilon symbol (special terminal)
+CompiledCFG
+    A frozen grammar in normal form, for many membership queries
+EarleyParser
+    A parser for any grammar, giving shared packed parse forests
+LRParser
+    A table-driven LALR(1) or LR(1) parser
 
 """
 
@@ -24,12 +30,18 @@ from .variable import Variable
 from .terminal import Terminal
 from .production import Production
 from .cfg import CFG
+from .compiled_cfg import CompiledCFG
 from .epsilon import Epsilon
 from .llone_parser import LLOneParser
+from .earley_parser import EarleyParser
+from .lr_parser import LRParser
 
 __all__ = ["Variable",
            "Terminal",
            "Production",
            "CFG",
            "Epsilon",
-           "LLOneParser"]
+           "CompiledCFG",
+           "LLOneParser",
+           "EarleyParser",
+           "LRParser"]
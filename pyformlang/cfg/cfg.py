@@ -1,8 +1,6 @@
 """ A context free grammar """
-import dataclasses
 import re
 import string
-from collections import defaultdict
 from copy import deepcopy
 from typing import AbstractSet, Iterable, Tuple, Dict, Any, Union
 
@@ -17,7 +15,8 @@ from pyformlang.pda import cfg_variable_converter as cvc
 from pyformlang import regular_expression
 from .cfg_object import CFGObject
 # pylint: disable=cyclic-import
-from .cyk_table import CYKTable, DerivationDoesNotExist
+from .compiled_cfg import CompiledCFG
+from .earley_parser import EarleyParser
 from .epsilon import Epsilon
 from .pda_object_creator import PDAObjectCreator
 from .production import Production
@@ -82,6 +81,7 @@ class CFG:
         for production in self._productions:
             self.__initialize_production_in_cfg(production)
         self._normal_form = None
+        self._compiled = None
         self._generating_symbols = None
         self._nullable_symbols = None
         self._impacts = None
@@ -713,25 +713,38 @@ class CFG:
     def __contains__(self, word: Iterable[Union[Terminal, str]]) -> bool:
         return self.contains(word)
 
-    def contains(self, word: Iterable[Union[Terminal, str]]) -> bool:
+    def contains(self, word: Iterable[Union[Terminal, str]],
+                 method: str = "cyk") -> bool:
         """ Gives the membership of a word to the grammar
 
+        The normal form is compiled once, on the first call using it.
+
         Parameters
         ----------
         word : iterable of :class:`~pyformlang.cfg.Terminal`
             The word to check
+        method : str, optional
+            The recognition algorithm:
+
+            * "cyk" (default) or "valiant": on the normal form, see \
+            :meth:`~pyformlang.cfg.CompiledCFG.contains`.
+            * "earley": on the grammar itself, with an \
+            :class:`~pyformlang.cfg.earley_parser.EarleyParser`. It is \
+            linear for most grammars met in practice.
 
         Returns
         ----------
         contains : bool
             Whether word if in the CFG or not
+
+        Raises
+        ----------
+        ValueError
+            If the method is unknown
         """
-        # Remove epsilons
-        word = [to_terminal(x) for x in word if x != Epsilon()]
-        if not word:
-            return self.generate_epsilon()
-        cyk_table = CYKTable(self, word)
-        return cyk_table.generate_word()
+        if method == "earley":
+            return EarleyParser(self).parse(word)
+        return self.compile().contains(word, method)
 
     def get_cnf_parse_tree(self, word):
         """
@@ -748,11 +761,32 @@ class CFG:
             The parse tree
 
         """
-        word = [to_terminal(x) for x in word if x != Epsilon()]
-        if not word and not self.generate_epsilon():
-            raise DerivationDoesNotExist
-        cyk_table = CYKTable(self, word)
-        return cyk_table.get_parse_tree()
+        return self.compile().get_cnf_parse_tree(word)
+
+    def compile(self) -> CompiledCFG:
+        """ Freezes the normal form of the grammar into integer-indexed \
+        productions, to answer many membership and parsing queries
+
+        The compiled grammar is built once and kept by the grammar, so the \
+        normal form and its indexes are shared by all the queries.
+
+        Returns
+        ----------
+        compiled_cfg : :class:`~pyformlang.cfg.compiled_cfg.CompiledCFG`
+            The compiled grammar
+
+        Examples
+        --------
+
+        >>> cfg = CFG.from_text("S -> a S b | a b")
+        >>> compiled_cfg = cfg.compile()
+        >>> compiled_cfg.contains("ab")
+        True
+
+        """
+        if self._compiled is None:
+            self._compiled = CompiledCFG(self)
+        return self._compiled
 
     def to_pda(self) -> "pda.PDA":
         """ Converts the CFG to a PDA that generates on empty stack an \
@@ -1169,71 +1203,3 @@ class CFG:
         Generates the suffix language of the CFL, i.e., the language containing all suffixes of valid words
         """
         return self.reverse().get_prefix_language().reverse()
-
-@dataclasses.dataclass(frozen=True)
-class EarleyParserState:
-    production: Production
-    position_in_body: int
-    position_in_word: int
-
-    def finished_production(self):
-        return self.position_in_body == len(self.production.body)
-
-class EarleyParser:
-    """
-    A class to parse words of a given CFG, aborting early (sic!) if invalid prefix
-    """
-
-    def __init__(self, cfg: CFG):
-        self.cfg = cfg
-        self.rules_by_head = defaultdict(list)
-        for p in self.cfg.productions:
-            self.rules_by_head[p.head].append(p)
-
-
-    def _init(self, word: list):
-        S = [set() for _ in range(len(word)+1)]
-        return S
-
-    def _complete(self, state: EarleyParserState, k: int, S: list[set[EarleyParserState]]):
-        for new_state in S[state.position_in_word]:
-            try:
-                index_in_body = new_state.production.body.index(state.production.head)
-                if index_in_body == new_state.position_in_body:
-                    S[k].add(EarleyParserState(
-                        new_state.production,
-                        index_in_body+1,
-                        new_state.position_in_word,
-                    ))
-            except ValueError:
-                continue
-
-    def _predict(self, state: EarleyParserState, k: int, S: list[set[EarleyParserState]]):
-        nonterminal = state.production.body[state.position_in_body]
-        for production in self.rules_by_head[nonterminal]:
-            S[k].add(EarleyParserState(production, 0, k))
-
-    def _scan(self, state: EarleyParserState, k: int, word: list, S: list[set[EarleyParserState]]):
-        if state.position_in_word < len(word) and state.production.body[state.position_in_body].value == word[k]:
-            S[k+1].add(EarleyParserState(state.production, state.position_in_body+1, state.position_in_word))
-
-
-    def parse(self, word: list):
-        # based on https://en.wikipedia.org/wiki/Earley_parser
-        S: list[set[EarleyParserState]] = self._init(word)
-        processed = set()
-        # S contains tuples of (production, position in production, position in word)
-        S[0].add(EarleyParserState(Production(Variable("γ"), [self.cfg.start_symbol]), 0, 0))
-        for k in range(len(word)+1):
-            while remaining := S[k].difference(processed):
-                processed.update(remaining)
-                for state in remaining:
-                    if state.finished_production():
-                        self._complete(state, k, S)
-                    else:
-                        if isinstance(state.production.body[state.position_in_body], Variable):
-                            self._predict(state, k, S)
-                        else:
-                            self._scan(state, k, word, S)
-        start_productions = [p for p in self.cfg.productions if p.head == self.cfg.start_symbol]
-        return any(EarleyParserState(s, len(s.body), 0) in S[len(word)] for s in start_productions)
@@ -0,0 +1,242 @@
+"""
+A frozen, integer-indexed representation of a grammar in normal form
+"""
+
+from typing import Iterable, List, Optional, Tuple, Union
+
+from .cyk_table import CYKTable, CYKNode, DerivationDoesNotExist
+from .valiant_table import ValiantTable
+from .epsilon import Epsilon
+from .parse_tree import ParseTree
+from .terminal import Terminal
+from .utils import to_terminal
+
+
+class CompiledCFG:
+    """ A frozen version of a context-free grammar, meant to be reused for \
+    many membership and parsing queries.
+
+    The Chomsky normal form of the grammar is computed once, and its \
+    variables are numbered from 0 so that sets of variables are integers \
+    used as bitsets. The productions are indexed: the terminal ones by \
+    their terminal, and the binary ones by the first variable of their \
+    body. The CYK tables of the queries are filled with these indexes.
+
+    The compiled grammar does not follow later modifications of the \
+    grammar it was built from.
+
+    Parameters
+    ----------
+    cfg : :class:`~pyformlang.cfg.CFG`
+        The grammar to compile
+
+    Examples
+    --------
+
+    >>> cfg = CFG.from_text("S -> a S b | a b")
+    >>> compiled = cfg.compile()
+    >>> compiled.contains("aabb")
+    True
+    >>> compiled.contains(["a", "b", "b"])
+    False
+
+    """
+
+    # pylint: disable=too-many-instance-attributes
+    def __init__(self, cfg):
+        self._cnf = cfg.to_normal_form()
+        self._generates_epsilon = cfg.generate_epsilon()
+        self._variables = []
+        self._indexes = {}
+        # For a terminal, the variables producing it
+        self._terminal_heads = {}
+        # For a variable B, the pairs (C, heads of B C), and all the C
+        binary_rules = []
+        self._right_masks = []
+        for production in sorted(self._cnf.productions, key=str):
+            head = 1 << self._get_index(production.head, binary_rules)
+            body = production.body
+            if len(body) == 1:
+                self._terminal_heads[body[0]] = \
+                    self._terminal_heads.get(body[0], 0) | head
+            elif len(body) == 2:
+                left = self._get_index(body[0], binary_rules)
+                right = self._get_index(body[1], binary_rules)
+                rules = binary_rules[left]
+                rules[right] = rules.get(right, 0) | head
+                self._right_masks[left] |= 1 << right
+        self._binary_rules = [[(1 << right, heads)
+                               for right, heads in rules.items()]
+                              for rules in binary_rules]
+        self._start = self._indexes.get(self._cnf.start_symbol)
+
+    def _get_index(self, variable, binary_rules) -> int:
+        index = self._indexes.get(variable)
+        if index is None:
+            index = len(self._variables)
+            self._indexes[variable] = index
+            self._variables.append(variable)
+            binary_rules.append({})
+            self._right_masks.append(0)
+        return index
+
+    def __len__(self):
+        """ The number of variables of the normal form """
+        return len(self._variables)
+
+    @property
+    def start_symbol(self):
+        """ The start symbol of the grammar """
+        return self._cnf.start_symbol
+
+    @property
+    def start_index(self) -> Optional[int]:
+        """ The number of the start symbol, None if it has no production """
+        return self._start
+
+    def get_variable(self, index: int):
+        """ Gives the variable of a number """
+        return self._variables[index]
+
+    def get_terminal_heads(self, terminal: Terminal) -> int:
+        """ Gives the variables producing a terminal, as a bitset """
+        return self._terminal_heads.get(terminal, 0)
+
+    def get_heads(self, left_variables: int, right_variables: int) -> int:
+        """ Gives the variables producing a variable of a set followed by a \
+        variable of another set
+
+        Parameters
+        ----------
+        left_variables : int
+            The set of the first variables, as a bitset
+        right_variables : int
+            The set of the second variables, as a bitset
+
+        Returns
+        ----------
+        heads : int
+            The heads of the productions, as a bitset
+        """
+        heads = 0
+        binary_rules = self._binary_rules
+        right_masks = self._right_masks
+        while left_variables:
+            lowest = left_variables & -left_variables
+            left = lowest.bit_length() - 1
+            if right_masks[left] & right_variables:
+                for right, rule_heads in binary_rules[left]:
+                    if right & right_variables:
+                        heads |= rule_heads
+            left_variables ^= lowest
+        return heads
+
+    def get_binary_bodies(self) -> List[Tuple[int, int, int]]:
+        """ Gives the bodies of the binary productions
+
+        Returns
+        ----------
+        bodies : list of tuple of int
+            For each body, the numbers of its two variables and the \
+            variables producing it, as a bitset
+        """
+        return [(left, right.bit_length() - 1, heads)
+                for left, rules in enumerate(self._binary_rules)
+                for right, heads in rules]
+
+    def get_body(self, head: int, left_variables: int,
+                 right_variables: int) -> Optional[Tuple[int, int]]:
+        """ Finds a binary production of a variable whose body is a \
+        variable of a set followed by a variable of another set
+
+        Parameters
+        ----------
+        head : int
+            The number of the variable
+        left_variables : int
+            The set of the first variables, as a bitset
+        right_variables : int
+            The set of the second variables, as a bitset
+
+        Returns
+        ----------
+        body : tuple of int, or None
+            The numbers of the variables of the body, None if there is no \
+            such production
+        """
+        head_mask = 1 << head
+        while left_variables:
+            lowest = left_variables & -left_variables
+            left = lowest.bit_length() - 1
+            for right, heads in self._binary_rules[left]:
+                if heads & head_mask and right & right_variables:
+                    return left, right.bit_length() - 1
+            left_variables ^= lowest
+        return None
+
+    def contains(self, word: Iterable[Union[Terminal, str]],
+                 method: str = "cyk") -> bool:
+        """ Gives the membership of a word to the grammar
+
+        Parameters
+        ----------
+        word : iterable of :class:`~pyformlang.cfg.Terminal`
+            The word to check
+        method : str, optional
+            The recognition algorithm:
+
+            * "cyk" (default): the CYK algorithm, with bitsets of variables.
+            * "valiant": the algorithm of Valiant, with boolean matrix \
+            products computed by numpy. It is meant for long words, and \
+            needs a memory quadratic in their length.
+
+        Returns
+        ----------
+        contains : bool
+            Whether word if in the grammar or not
+
+        Raises
+        ----------
+        ValueError
+            If the method is unknown
+        """
+        if method not in ("cyk", "valiant"):
+            raise ValueError("Unknown recognition method " + method)
+        word = _to_word(word)
+        if not word:
+            return self._generates_epsilon
+        if method == "valiant":
+            return ValiantTable(self, word).generate_word()
+        return CYKTable(self, word).generate_word()
+
+    def get_cnf_parse_tree(self, word: Iterable[Union[Terminal, str]]) \
+            -> ParseTree:
+        """
+        Get a parse tree of the CNF of the grammar
+
+        Parameters
+        ----------
+        word : iterable of :class:`~pyformlang.cfg.Terminal`
+            The word to look for
+
+        Returns
+        -------
+        derivation : :class:`~pyformlang.cfg.ParseTree`
+            The parse tree
+
+        Raises
+        ------
+        DerivationDoesNotExist
+            If the word is not in the grammar
+        """
+        word = _to_word(word)
+        if not word:
+            if not self._generates_epsilon:
+                raise DerivationDoesNotExist
+            return CYKNode(self.start_symbol)
+        return CYKTable(self, word).get_parse_tree()
+
+
+def _to_word(word: Iterable[Union[Terminal, str]]) -> List[Terminal]:
+    """ Turns a word into terminals, removing the epsilons """
+    return [to_terminal(x) for x in word if x != Epsilon()]
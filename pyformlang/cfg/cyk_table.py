@@ -9,33 +9,30 @@ class CYKTable:
     """
     A CYK table
 
+    Each cell of the table is the set of the variables generating a factor \
+    of the word, as an integer used as a bitset of the numbers of the \
+    variables in the compiled grammar. A cell is filled with bitwise \
+    operations only. No parse tree is built while recognizing: it is \
+    rebuilt from the table when asked.
+
     Parameters
     ----------
-    cfg : A context-free grammar
-    word : iterable of Terminals
+    compiled_cfg : :class:`~pyformlang.cfg.compiled_cfg.CompiledCFG`
+        The compiled grammar
+    word : list of Terminals
         The word from which we construct the CYK table
     """
 
-    def __init__(self, cfg, word):
-        self._cnf = cfg.to_normal_form()
+    def __init__(self, compiled_cfg, word):
+        self._compiled_cfg = compiled_cfg
         self._word = word
-        self._productions_d = {}
-        self._set_productions_by_body()
-        self._cyk_table = {}
-        if not self._generates_all_terminals():
-            self._cyk_table[(0, len(self._word))] = set()
-        else:
+        # self._cyk_table[start][end] is the set of variables generating the
+        # factor from start to end
+        self._cyk_table = [[0] * (len(self._word) + 1)
+                           for _ in range(len(self._word) + 1)]
+        if self._generates_all_terminals():
             self._set_cyk_table()
 
-    def _set_productions_by_body(self):
-        # Organize productions
-        for production in self._cnf.productions:
-            temp = tuple(production.body)
-            if temp in self._productions_d:
-                self._productions_d[temp].append(production.head)
-            else:
-                self._productions_d[temp] = [production.head]
-
     def _set_cyk_table(self):
         self._initialize_cyk_table()
         self._propagate_in_cyk_table()
@@ -46,32 +43,23 @@ class CYKTable:
             for start_window in range(len(self._word) - window_size + 1):
                 yield start_window, start_window + window_size
 
-    def _get_all_window_pairs(self, start_window, end_window):
-        for mid_window in range(start_window + 1, end_window):
-            for var_b in self._cyk_table[(start_window, mid_window)]:
-                for var_c in self._cyk_table[(mid_window, end_window)]:
-                    yield var_b, var_c
-
     def _propagate_in_cyk_table(self):
+        table = self._cyk_table
+        get_heads = self._compiled_cfg.get_heads
         for start_window, end_window in self._get_windows():
-            for var_b, var_c in self._get_all_window_pairs(start_window,
-                                                           end_window):
-                for var_a in self._productions_d.get((var_b.value,
-                                                      var_c.value), []):
-                    self._cyk_table[(start_window, end_window)].add(
-                        CYKNode(var_a, var_b, var_c))
+            row = table[start_window]
+            heads = 0
+            for mid_window in range(start_window + 1, end_window):
+                left_variables = row[mid_window]
+                right_variables = table[mid_window][end_window]
+                if left_variables and right_variables:
+                    heads |= get_heads(left_variables, right_variables)
+            row[end_window] = heads
 
     def _initialize_cyk_table(self):
         for i, terminal in enumerate(self._word):
-            self._cyk_table[(i, i + 1)] = \
-                {CYKNode(x, CYKNode(terminal))
-                 for x in self._productions_d[(terminal,)]}
-        for window_size in range(2, len(self._word) + 1):
-            for start_window in range(len(self._word) - window_size + 1):
-                # We use set because we do not want duplicate
-                # It makes iterations longer
-                self._cyk_table[
-                    (start_window, start_window + window_size)] = set()
+            self._cyk_table[i][i + 1] = \
+                self._compiled_cfg.get_terminal_heads(terminal)
 
     def generate_word(self):
         """
@@ -81,31 +69,57 @@ class CYKTable:
         is_generated : bool
 
         """
-        return self._cnf.start_symbol in self._cyk_table[(0, len(self._word))]
+        start = self._compiled_cfg.start_index
+        return start is not None and \
+            (self._cyk_table[0][len(self._word)] >> start) & 1 == 1
 
     def _generates_all_terminals(self):
-        generate_all_terminals = True
-        for terminal in self._word:
-            if (terminal,) not in self._productions_d:
-                generate_all_terminals = False
-        return generate_all_terminals
+        return all(self._compiled_cfg.get_terminal_heads(terminal)
+                   for terminal in self._word)
+
+    def _get_split(self, head, start_window, end_window):
+        """ Finds a production of the head and where it splits the \
+        factor, as the middle and the variables of the body """
+        table = self._cyk_table
+        for mid_window in range(start_window + 1, end_window):
+            body = self._compiled_cfg.get_body(
+                head, table[start_window][mid_window],
+                table[mid_window][end_window])
+            if body is not None:
+                return (mid_window,) + body
+        raise DerivationDoesNotExist
 
     def get_parse_tree(self):
         """
         Give the parse tree associated with this CYK Table
 
+        The tree is rebuilt from the root, choosing for each variable a \
+        production and a split of its factor allowed by the table.
+
         Returns
         -------
         parse_tree : :class:`~pyformlang.cfg.ParseTree`
         """
         if self._word and not self.generate_word():
             raise DerivationDoesNotExist
+        root = CYKNode(self._compiled_cfg.start_symbol)
         if not self._word:
-            return CYKNode(self._cnf.start_symbol)
-        root = [
-            x
-            for x in self._cyk_table[(0, len(self._word))]
-            if x == self._cnf.start_symbol][0]
+            return root
+        get_variable = self._compiled_cfg.get_variable
+        to_process = [(root, self._compiled_cfg.start_index, 0,
+                       len(self._word))]
+        while to_process:
+            node, head, start_window, end_window = to_process.pop()
+            if end_window == start_window + 1:
+                node.set_sons(CYKNode(self._word[start_window]))
+                continue
+            mid_window, left, right = self._get_split(head, start_window,
+                                                      end_window)
+            left_son = CYKNode(get_variable(left))
+            right_son = CYKNode(get_variable(right))
+            node.set_sons(left_son, right_son)
+            to_process.append((left_son, left, start_window, mid_window))
+            to_process.append((right_son, right, mid_window, end_window))
         return root
 
 
@@ -122,6 +136,13 @@ class CYKNode(ParseTree):
         if right_son is not None:
             self.sons.append(right_son)
 
+    def set_sons(self, left_son, right_son=None):
+        """ Sets the sons of the node """
+        self.left_son = left_son
+        self.right_son = right_son
+        self.sons = [son for son in (left_son, right_son)
+                     if son is not None]
+
     def __eq__(self, other):
         if isinstance(other, CYKNode):
             return self.value == other.value
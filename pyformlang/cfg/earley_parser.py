@@ -0,0 +1,571 @@
+""" An Earley parser, building a shared packed parse forest on demand """
+
+from typing import Dict, Iterable, List, Optional, Tuple, Union
+
+from .cyk_table import DerivationDoesNotExist
+from .epsilon import Epsilon
+from .parse_tree import ParseTree
+from .production import Production
+from .terminal import Terminal
+from .utils import to_terminal
+from .variable import Variable
+
+# The head of the production deriving the start symbol, added to the grammar
+_START = object()
+
+# An item: the number of a production, the position of the dot in its body
+# and the position in the word where the production starts
+Item = Tuple[int, int, int]
+
+
+class EarleyParser:
+    """
+    A class to parse words of a given CFG, aborting early (sic!) if invalid \
+    prefix
+
+    The grammar does not need to be in normal form. Each set of the chart \
+    indexes its items by the variable they expect next, so that a \
+    completion only visits the items it advances. Following Aycock and \
+    Horspool, an item expecting a nullable variable is advanced over it as \
+    soon as it is added. Following Leo, the completions along a chain of \
+    right-recursive productions are done in one step, so that the \
+    recognition takes a linear time for all LR-regular grammars.
+
+    The parse forest records all the derivations of the word, with shared \
+    sub-derivations, in a size polynomial in the length of the word even \
+    when there are exponentially many derivations.
+
+    Parameters
+    ----------
+    cfg : :class:`~pyformlang.cfg.CFG`
+        A context-free Grammar
+
+    Examples
+    --------
+
+    >>> cfg = CFG.from_text("S -> S + S | a")
+    >>> parser = EarleyParser(cfg)
+    >>> parser.parse(["a", "+", "a"])
+    True
+    >>> parser.get_parse_forest("a+a+a").is_ambiguous()
+    True
+
+    """
+
+    def __init__(self, cfg):
+        self.cfg = cfg
+        productions = sorted(cfg.productions, key=str)
+        productions.append(Production(_START, [cfg.start_symbol]))
+        self._productions = productions
+        self._heads = [production.head for production in productions]
+        self._bodies = [tuple(production.body) for production in productions]
+        self._nullables = cfg.get_nullable_symbols()
+        self._rules_by_head = {}
+        for index, production in enumerate(productions[:-1]):
+            self._rules_by_head.setdefault(production.head, []).append(
+                index)
+
+    def parse(self, word: Iterable[Union[Terminal, str]]) -> bool:
+        """ Gives the membership of a word to the grammar
+
+        Parameters
+        ----------
+        word : iterable of :class:`~pyformlang.cfg.Terminal`
+            The word to check
+
+        Returns
+        ----------
+        contains : bool
+            Whether word if in the CFG or not
+        """
+        word = _to_word(word)
+        chart = _Chart(self, word, with_forest=False)
+        return chart.is_accepted()
+
+    def get_parse_forest(self, word: Iterable[Union[Terminal, str]]) \
+            -> "ParseForestNode":
+        """
+        Gives the shared packed parse forest of a word
+
+        The completions skipped by Leo's optimization are put back only \
+        in the sets reached by the forest.
+
+        Parameters
+        ----------
+        word : iterable of :class:`~pyformlang.cfg.Terminal`
+            The word to parse
+
+        Returns
+        -------
+        forest : :class:`~pyformlang.cfg.earley_parser.ParseForestNode`
+            The node of the start symbol over the whole word
+
+        Raises
+        ------
+        DerivationDoesNotExist
+            If the word is not in the grammar
+        """
+        word = _to_word(word)
+        chart = _Chart(self, word, with_forest=True)
+        if not chart.is_accepted():
+            raise DerivationDoesNotExist
+        return chart.get_forest()
+
+    def get_parse_tree(self, word: Iterable[Union[Terminal, str]]) \
+            -> ParseTree:
+        """
+        Gives a parse tree of a word, in the grammar itself rather than in \
+        its normal form
+
+        Parameters
+        ----------
+        word : iterable of :class:`~pyformlang.cfg.Terminal`
+            The word to parse
+
+        Returns
+        -------
+        parse_tree : :class:`~pyformlang.cfg.ParseTree`
+            A parse tree of the word
+
+        Raises
+        ------
+        DerivationDoesNotExist
+            If the word is not in the grammar
+        """
+        return self.get_parse_forest(word).get_parse_tree()
+
+    def get_rules(self, head: Variable) -> List[int]:
+        """ Gives the numbers of the productions of a variable """
+        return self._rules_by_head.get(head, [])
+
+    def get_production(self, index: int) -> Production:
+        """ Gives the production of a number """
+        return self._productions[index]
+
+    def get_head(self, index: int):
+        """ Gives the head of the production of a number """
+        return self._heads[index]
+
+    def get_body(self, index: int) -> tuple:
+        """ Gives the body of the production of a number """
+        return self._bodies[index]
+
+    def is_nullable(self, symbol) -> bool:
+        """ Whether a symbol generates the empty word """
+        return symbol in self._nullables
+
+    @property
+    def start_index(self) -> int:
+        """ The number of the production deriving the start symbol """
+        return len(self._productions) - 1
+
+
+class _Chart:
+    """ The sets of items of the Earley algorithm for a word """
+
+    # pylint: disable=too-many-instance-attributes
+    def __init__(self, parser: EarleyParser, word: List[Terminal],
+                 with_forest: bool):
+        self._parser = parser
+        self._word = word
+        self._with_forest = with_forest
+        # For each set, its items, with the positions splitting them when
+        # building a forest
+        self._items: List[Dict[Item, List[int]]] = []
+        # For each set, the items by the variable they expect next
+        self._waiting: List[Dict[Variable, List[Item]]] = []
+        # For each set, the topmost items completed by a variable, following
+        # Leo
+        self._leo_items: List[Dict[Variable, Optional[Item]]] = []
+        # For each set, the completed productions by head and start
+        self._completed: List[Dict[Tuple[Variable, int], List[int]]] = []
+        # For each set, the variables and their starts whose completions
+        # were replaced by a Leo item, and the sets where they were put back
+        self._leo_links: List[Dict[Tuple[Variable, int], None]] = []
+        self._expanded = set()
+        self._fill()
+
+    @property
+    def parser(self) -> EarleyParser:
+        """ The parser filling the chart """
+        return self._parser
+
+    @property
+    def word(self) -> List[Terminal]:
+        """ The word read """
+        return self._word
+
+    def _fill(self):
+        start = self._parser.start_index
+        next_items = {(start, 0, 0): []}
+        for position in range(len(self._word) + 1):
+            if not next_items:
+                return
+            next_items = self._process_set(position, next_items)
+
+    def _process_set(self, position: int, items: Dict[Item, List[int]]) \
+            -> Dict[Item, List[int]]:
+        """ Completes and predicts the items of a set, and gives the items \
+        of the next set """
+        # pylint: disable=too-many-locals
+        parser = self._parser
+        word = self._word
+        with_forest = self._with_forest
+        waiting = {}
+        completed = {}
+        self._items.append(items)
+        self._waiting.append(waiting)
+        self._leo_items.append({})
+        self._completed.append(completed)
+        self._leo_links.append({})
+        next_items = {}
+        next_terminal = word[position] if position < len(word) else None
+        to_process = list(items)
+        while to_process:
+            item = to_process.pop()
+            production, dot, origin = item
+            body = parser.get_body(production)
+            if dot == len(body):
+                head = parser.get_head(production)
+                if with_forest:
+                    completed.setdefault((head, origin), []).append(
+                        production)
+                # The nullable variables are skipped when predicted
+                if origin != position:
+                    self._complete(head, origin, position, items,
+                                   to_process)
+                continue
+            symbol = body[dot]
+            if isinstance(symbol, Variable):
+                expecting = waiting.get(symbol)
+                if expecting is None:
+                    waiting[symbol] = [item]
+                    for predicted in parser.get_rules(symbol):
+                        _add_item(items, (predicted, 0, position), None,
+                                  to_process)
+                else:
+                    expecting.append(item)
+                if parser.is_nullable(symbol):
+                    _add_item(items, (production, dot + 1, origin),
+                              position if with_forest else None,
+                              to_process)
+            elif next_terminal is not None and symbol == next_terminal:
+                _add_item(next_items, (production, dot + 1, origin),
+                          position if with_forest else None, None)
+        return next_items
+
+    def _complete(self, head, origin: int, position: int,
+                  items: Dict[Item, List[int]], to_process: List[Item]):
+        """ Advances the items of the origin expecting a completed \
+        variable """
+        leo_item = self._get_leo_item(origin, head)
+        if leo_item is not None:
+            _add_item(items, leo_item, None, to_process)
+            if self._with_forest:
+                self._leo_links[position][(head, origin)] = None
+            return
+        split = origin if self._with_forest else None
+        for production, dot, parent_origin in \
+                self._waiting[origin].get(head, []):
+            _add_item(items, (production, dot + 1, parent_origin), split,
+                      to_process)
+
+    def _get_leo_item(self, position: int, head) -> Optional[Item]:
+        """ Gives the topmost item completed by a variable in a set, when \
+        the completions starting from the variable are deterministic, that \
+        is when each one advances a single item to the end of its body """
+        chain = []
+        while True:
+            leo_items = self._leo_items[position]
+            if head in leo_items:
+                leo_item = leo_items[head]
+                break
+            expecting = self._waiting[position].get(head, [])
+            if len(expecting) != 1 or \
+                    expecting[0][1] + 1 != \
+                    len(self._parser.get_body(expecting[0][0])):
+                leo_items[head] = None
+                leo_item = None
+                break
+            production, dot, origin = expecting[0]
+            chain.append((leo_items, head, (production, dot + 1, origin)))
+            head = self._parser.get_head(production)
+            position = origin
+        for leo_items, chain_head, completed_item in reversed(chain):
+            if leo_item is None:
+                leo_item = completed_item
+            leo_items[chain_head] = leo_item
+        return leo_item
+
+    def is_accepted(self) -> bool:
+        """ Whether the word is generated """
+        if len(self._items) <= len(self._word):
+            return False
+        return (self._parser.start_index, 1, 0) in self._items[-1]
+
+    def get_completed(self, position: int) \
+            -> Dict[Tuple[Variable, int], List[int]]:
+        """ Gives the completed productions of a set, by head and start """
+        self._expand_leo_links(position)
+        return self._completed[position]
+
+    def get_splits(self, position: int, item: Item) -> List[int]:
+        """ Gives the positions where the last symbol read by an item of a \
+        set starts """
+        self._expand_leo_links(position)
+        return self._items[position][item]
+
+    def _expand_leo_links(self, position: int):
+        """ Puts back in a set the completions replaced by Leo items """
+        if position in self._expanded:
+            return
+        self._expanded.add(position)
+        items = self._items[position]
+        completed = self._completed[position]
+        for head, origin in self._leo_links[position]:
+            leo_item = self._leo_items[origin][head]
+            item = None
+            while item != leo_item:
+                production, dot, parent_origin = \
+                    self._waiting[origin][head][0]
+                item = (production, dot + 1, parent_origin)
+                head = self._parser.get_head(production)
+                if item not in items:
+                    completed.setdefault((head, parent_origin), []).append(
+                        production)
+                _add_item(items, item, origin, None)
+                origin = parent_origin
+
+    def get_forest(self) -> "ParseForestNode":
+        """ Builds the parse forest of the word """
+        return _ForestBuilder(self).build()
+
+
+def _add_item(items: Dict[Item, List[int]], item: Item,
+              split: Optional[int], to_process: Optional[List[Item]]):
+    """ Adds an item to a set, with a position splitting it """
+    splits = items.get(item)
+    if splits is None:
+        items[item] = [] if split is None else [split]
+        if to_process is not None:
+            to_process.append(item)
+    elif split is not None and split not in splits:
+        splits.append(split)
+
+
+class ParseForestNode:
+    """
+    A node of a shared packed parse forest (SPPF)
+
+    A symbol node tells how a symbol generates the factor of the word \
+    between two positions. An intermediate node tells how the beginning of \
+    the body of a production does, its value being the production and its \
+    position the length of the beginning.
+
+    Each family of a node is one way of deriving the factor, as a tuple of \
+    nodes:
+
+    * For a symbol node, the family of a production with an empty body is \
+      empty, the family of a production with a single symbol holds the \
+      node of this symbol, and the family of a longer production holds the \
+      intermediate node of its body without the last symbol, followed by \
+      the node of the last symbol.
+    * For an intermediate node, the families are built in the same way.
+    * A terminal node has no family.
+
+    Parameters
+    ----------
+    value : :class:`~pyformlang.cfg.CFGObject` or \
+    :class:`~pyformlang.cfg.Production`
+        The symbol, or the production of an intermediate node
+    start : int
+        The position where the factor starts
+    end : int
+        The position where the factor ends
+    position : int, optional
+        For an intermediate node, the number of symbols of the body
+    """
+
+    def __init__(self, value, start: int, end: int, position: int = None):
+        self.value = value
+        self.start = start
+        self.end = end
+        self.position = position
+        self.families: List[Tuple["ParseForestNode", ...]] = []
+
+    def __repr__(self):
+        if self.is_intermediate():
+            return "ParseForestNode(" + str(self.value) + ", " + \
+                str(self.position) + ", " + str(self.start) + ", " + \
+                str(self.end) + ")"
+        return "ParseForestNode(" + str(self.value) + ", " + \
+            str(self.start) + ", " + str(self.end) + ")"
+
+    def is_intermediate(self) -> bool:
+        """ Whether the node stands for the beginning of a body """
+        return self.position is not None
+
+    def get_nodes(self) -> List["ParseForestNode"]:
+        """ Gives the nodes reachable from this one, this one first """
+        nodes = [self]
+        seen = {id(self)}
+        index = 0
+        while index < len(nodes):
+            node = nodes[index]
+            index += 1
+            for family in node.families:
+                for son in family:
+                    if id(son) not in seen:
+                        seen.add(id(son))
+                        nodes.append(son)
+        return nodes
+
+    def is_ambiguous(self) -> bool:
+        """ Whether the factor has several parse trees """
+        return any(len(node.families) > 1 for node in self.get_nodes())
+
+    def get_parse_tree(self) -> ParseTree:
+        """
+        Gives one of the parse trees of the forest
+
+        The families are chosen so that the tree is finite, even when the \
+        grammar has cycles.
+
+        Returns
+        -------
+        parse_tree : :class:`~pyformlang.cfg.ParseTree`
+            A parse tree, whose intermediate nodes are flattened
+        """
+        choices = _get_finite_families(self.get_nodes())
+        root = ParseTree(self.value)
+        to_process = [(root, self)]
+        while to_process:
+            tree, node = to_process.pop()
+            for son in _get_sons(node, choices):
+                son_tree = ParseTree(son.value)
+                tree.sons.append(son_tree)
+                to_process.append((son_tree, son))
+        return root
+
+
+def _get_finite_families(nodes: List[ParseForestNode]) \
+        -> Dict[int, Tuple[ParseForestNode, ...]]:
+    """ Chooses for each node a family leading to a finite tree """
+    choices = {}
+    # For each node, its families waiting for a son to be chosen
+    waiting = {}
+    remaining = {}
+    to_process = []
+    for node in nodes:
+        if not node.families:
+            to_process.append(node)
+        for family in node.families:
+            sons = {id(son) for son in family}
+            remaining[(id(node), id(family))] = len(sons)
+            if not sons:
+                choices.setdefault(id(node), family)
+            for son in sons:
+                waiting.setdefault(son, []).append((node, family))
+        if id(node) in choices:
+            to_process.append(node)
+    done = set()
+    while to_process:
+        node = to_process.pop()
+        if id(node) in done:
+            continue
+        done.add(id(node))
+        for parent, family in waiting.get(id(node), []):
+            key = (id(parent), id(family))
+            remaining[key] -= 1
+            if remaining[key] == 0 and id(parent) not in choices:
+                choices[id(parent)] = family
+                to_process.append(parent)
+    return choices
+
+
+def _get_sons(node: ParseForestNode,
+              choices: Dict[int, Tuple[ParseForestNode, ...]]) \
+        -> List[ParseForestNode]:
+    """ The symbol nodes under a node, with the intermediate nodes \
+    flattened """
+    sons = []
+    family = choices.get(id(node), ())
+    while family and family[0].is_intermediate():
+        sons.append(family[1])
+        family = choices[id(family[0])]
+    sons.extend(reversed(family))
+    sons.reverse()
+    return sons
+
+
+class _ForestBuilder:  # pylint: disable=too-few-public-methods
+    """ Builds the parse forest from the chart """
+
+    def __init__(self, chart: _Chart):
+        self._chart = chart
+        self._parser = chart.parser
+        self._nodes = {}
+        self._to_process = []
+
+    def build(self) -> ParseForestNode:
+        """ Builds the nodes reachable from the start symbol """
+        root = self._get_symbol_node(self._parser.cfg.start_symbol, 0,
+                                     len(self._chart.word))
+        while self._to_process:
+            node, key = self._to_process.pop()
+            if node.is_intermediate():
+                production, dot, origin, end = key
+                node.families = self._get_families(production, dot,
+                                                   origin, end)
+            elif isinstance(node.value, Variable):
+                for production in self._chart.get_completed(node.end).get(
+                        (node.value, node.start), []):
+                    node.families += self._get_families(
+                        production,
+                        len(self._parser.get_body(production)),
+                        node.start, node.end)
+        return root
+
+    def _get_families(self, production: int, dot: int, origin: int,
+                      end: int) -> List[Tuple[ParseForestNode, ...]]:
+        """ The families of the item of a production read up to a dot """
+        body = self._parser.get_body(production)
+        if dot == 0:
+            return [()]
+        if dot == 1:
+            return [(self._get_symbol_node(body[0], origin, end),)]
+        return [(self._get_item_node(production, dot - 1, origin, split),
+                 self._get_symbol_node(body[dot - 1], split, end))
+                for split in self._chart.get_splits(
+                    end, (production, dot, origin))]
+
+    def _get_item_node(self, production: int, dot: int, origin: int,
+                       end: int) -> ParseForestNode:
+        """ The node of the beginning of a body """
+        if dot == 1:
+            return self._get_symbol_node(self._parser.get_body(production)[0],
+                                         origin, end)
+        key = (production, dot, origin, end)
+        node = self._nodes.get(key)
+        if node is None:
+            node = ParseForestNode(self._parser.get_production(production),
+                                   origin, end, dot)
+            self._nodes[key] = node
+            self._to_process.append((node, key))
+        return node
+
+    def _get_symbol_node(self, symbol, start: int, end: int) \
+            -> ParseForestNode:
+        """ The node of a symbol """
+        key = (symbol, start, end)
+        node = self._nodes.get(key)
+        if node is None:
+            node = ParseForestNode(symbol, start, end)
+            self._nodes[key] = node
+            self._to_process.append((node, key))
+        return node
+
+
+def _to_word(word: Iterable[Union[Terminal, str]]) -> List[Terminal]:
+    """ Turns a word into terminals, removing the epsilons """
+    return [to_terminal(x) for x in word if x != Epsilon()]
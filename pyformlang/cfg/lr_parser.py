@@ -0,0 +1,550 @@
+""" LR(1) and LALR(1) parsers """
+
+from typing import Any, Dict, Iterable, List, Optional, Set, Tuple, Union
+
+from pyformlang.cfg.epsilon import Epsilon
+from pyformlang.cfg.cfg import NotParsableException
+from pyformlang.cfg.parse_tree import ParseTree
+from pyformlang.cfg.production import Production
+from pyformlang.cfg.terminal import Terminal
+from pyformlang.cfg.utils import to_terminal
+from pyformlang.cfg.variable import Variable
+
+# The lookahead standing for the end of the word
+_END = object()
+# The lookahead of an item whose lookaheads are propagated to its successors
+_PROPAGATED = object()
+
+# An item without its lookaheads: the number of a production and the
+# position of the dot in its body
+Core = Tuple[int, int]
+
+
+class LRConflict:
+    """
+    A cell of the parsing table with several actions
+
+    Parameters
+    ----------
+    state : int
+        The state of the automaton
+    lookahead : :class:`~pyformlang.cfg.Terminal` or None
+        The next terminal, None for the end of the word
+    shift : int or None
+        The state to shift to, None when the conflict is between reductions
+    productions : list of :class:`~pyformlang.cfg.Production`
+        The productions to reduce
+    """
+
+    # pylint: disable=too-few-public-methods
+    def __init__(self, state: int, lookahead: Optional[Terminal],
+                 shift: Optional[int], productions: List[Production]):
+        self.state = state
+        self.lookahead = lookahead
+        self.shift = shift
+        self.productions = productions
+
+    def __repr__(self):
+        kind = "shift/reduce" if self.shift is not None else "reduce/reduce"
+        lookahead = "$" if self.lookahead is None else str(self.lookahead)
+        return kind + " conflict in state " + str(self.state) + " on " + \
+            lookahead + ": " + ", ".join(map(str, self.productions))
+
+
+class LRParser:
+    """
+    A table-driven shift-reduce parser, for LALR(1) or canonical LR(1) \
+    grammars
+
+    The parsing tables are built once, from the LR(0) automaton with \
+    propagated lookaheads for LALR(1), or from the LR(1) automaton for \
+    canonical LR(1). A word is then parsed in a time linear in its length. \
+    The tables can be saved with :meth:`to_dict` and loaded with \
+    :meth:`from_dict`, which skips their construction.
+
+    Parameters
+    ----------
+    cfg : :class:`~pyformlang.cfg.CFG`
+        A context-free Grammar
+    method : str, optional
+        "lalr" (default) for LALR(1) tables, "lr" for canonical LR(1) \
+        tables, which have no more conflicts but more states
+
+    Raises
+    ------
+    ValueError
+        If the method is unknown
+
+    Examples
+    --------
+
+    >>> cfg = CFG.from_text("E -> E + T | T\\nT -> T * a | a",
+    ...                     start_symbol=Variable("E"))
+    >>> parser = LRParser(cfg)
+    >>> parser.is_parsable()
+    True
+    >>> parser.get_parse_tree("a+a*a").value
+    Variable(E)
+
+    """
+
+    def __init__(self, cfg, method: str = "lalr"):
+        if method not in ("lalr", "lr"):
+            raise ValueError("Unknown LR method " + method)
+        builder = _TableBuilder(cfg, method == "lr")
+        self._set_tables(builder.productions, builder.actions,
+                         builder.gotos, builder.conflicts)
+
+    def _set_tables(self, productions: List[Production],
+                    actions: List[Dict[Any, int]],
+                    gotos: List[Dict[Variable, int]],
+                    conflicts: List[Tuple[int, Any, List[int]]]):
+        """ Sets the tables, the action of a shift being the next state s \
+        and the one of a reduction by the production p being -1 - p """
+        self._productions = productions
+        self._actions = actions
+        self._gotos = gotos
+        self._conflicts = conflicts
+
+    def __len__(self):
+        """ The number of states of the automaton """
+        return len(self._actions)
+
+    @property
+    def conflicts(self) -> List[LRConflict]:
+        """ The cells of the parsing table with several actions """
+        conflicts = []
+        for state, lookahead, actions in self._conflicts:
+            shift = None
+            productions = []
+            for action in actions:
+                if action >= 0:
+                    shift = action
+                else:
+                    productions.append(self._productions[-1 - action])
+            conflicts.append(LRConflict(
+                state, None if lookahead is _END else lookahead, shift,
+                productions))
+        return conflicts
+
+    def is_parsable(self) -> bool:
+        """
+        Checks whether the grammar has no conflict, and so can be parsed
+
+        Returns
+        -------
+        is_parsable : bool
+        """
+        return not self._conflicts
+
+    def get_parse_tree(self, word: Iterable[Union[Terminal, str]]) \
+            -> ParseTree:
+        """
+        Get the parse tree of a word
+
+        Parameters
+        ----------
+        word : iterable of :class:`~pyformlang.cfg.Terminal`
+            The word to parse
+
+        Returns
+        -------
+        parse_tree : :class:`~pyformlang.cfg.ParseTree`
+            The parse tree
+
+        Raises
+        --------
+        NotParsableException
+            When the grammar has conflicts, or when the word is not in the \
+            grammar
+
+        """
+        if self._conflicts:
+            raise NotParsableException(repr(self.conflicts[0]))
+        actions = self._actions
+        gotos = self._gotos
+        productions = self._productions
+        states = [0]
+        nodes = []
+        for terminal in _get_terminals(word):
+            action = actions[states[-1]].get(terminal)
+            while action is not None and action < 0:
+                production = productions[-1 - action]
+                if production.head is None:
+                    return nodes[0]
+                node = ParseTree(production.head)
+                size = len(production.body)
+                if size:
+                    node.sons = nodes[-size:]
+                    del nodes[-size:]
+                    del states[-size:]
+                nodes.append(node)
+                states.append(gotos[states[-1]][production.head])
+                action = actions[states[-1]].get(terminal)
+            if action is None:
+                raise NotParsableException
+            states.append(action)
+            nodes.append(ParseTree(terminal))
+        raise NotParsableException
+
+    def contains(self, word: Iterable[Union[Terminal, str]]) -> bool:
+        """ Gives the membership of a word to the grammar
+
+        Parameters
+        ----------
+        word : iterable of :class:`~pyformlang.cfg.Terminal`
+            The word to check
+
+        Returns
+        ----------
+        contains : bool
+            Whether word if in the grammar or not
+
+        Raises
+        --------
+        NotParsableException
+            When the grammar has conflicts
+        """
+        if self._conflicts:
+            raise NotParsableException(repr(self.conflicts[0]))
+        try:
+            self.get_parse_tree(word)
+        except NotParsableException:
+            return False
+        return True
+
+    def to_dict(self) -> Dict[str, list]:
+        """
+        Gives the tables, made of lists, integers and the values of the \
+        symbols, so that they can be saved with json or pickle when the \
+        values of the symbols can
+
+        Returns
+        -------
+        tables : dict
+            The tables
+        """
+        variables = _Numbering()
+        terminals = _Numbering()
+
+        # The variables are numbered from -1 downwards, and the terminals
+        # from 0 upwards. The end of the word, only met as a lookahead,
+        # takes the place of the first variable.
+        def get_code(symbol) -> int:
+            if isinstance(symbol, Variable):
+                return -1 - variables.get(symbol)
+            if symbol is _END:
+                return -1
+            return terminals.get(symbol)
+
+        productions = [
+            [None if production.head is None
+             else get_code(production.head),
+             [get_code(symbol) for symbol in production.body]]
+            for production in self._productions]
+        actions = [[[get_code(lookahead), action]
+                    for lookahead, action in state_actions.items()]
+                   for state_actions in self._actions]
+        gotos = [[[get_code(variable), state]
+                  for variable, state in state_gotos.items()]
+                 for state_gotos in self._gotos]
+        conflicts = [[state, get_code(lookahead), list(actions_list)]
+                     for state, lookahead, actions_list in self._conflicts]
+        return {"variables": [x.value for x in variables.symbols],
+                "terminals": [x.value for x in terminals.symbols],
+                "productions": productions,
+                "actions": actions,
+                "gotos": gotos,
+                "conflicts": conflicts}
+
+    @classmethod
+    def from_dict(cls, tables: Dict[str, list]) -> "LRParser":
+        """
+        Loads tables given by :meth:`to_dict`
+
+        Parameters
+        ----------
+        tables : dict
+            The tables
+
+        Returns
+        -------
+        parser : :class:`~pyformlang.cfg.lr_parser.LRParser`
+            The parser using the tables
+        """
+        variables = [Variable(value) for value in tables["variables"]]
+        terminals = [Terminal(value) for value in tables["terminals"]]
+
+        def get_variable(code: int) -> Variable:
+            return variables[-1 - code]
+
+        def get_symbol(code: int):
+            if code >= 0:
+                return terminals[code]
+            return get_variable(code)
+
+        def get_lookahead(code: int):
+            return _END if code == -1 else terminals[code]
+
+        productions = [
+            Production(None if head is None else get_variable(head),
+                       [get_symbol(code) for code in body])
+            for head, body in tables["productions"]]
+        actions = [{get_lookahead(code): action for code, action in cells}
+                   for cells in tables["actions"]]
+        gotos = [{get_variable(code): state for code, state in cells}
+                 for cells in tables["gotos"]]
+        conflicts = [(state, get_lookahead(code), list(actions_list))
+                     for state, code, actions_list in tables["conflicts"]]
+        parser = cls.__new__(cls)
+        parser._set_tables(productions, actions, gotos, conflicts)
+        return parser
+
+
+class _Numbering:  # pylint: disable=too-few-public-methods
+    """ Numbers symbols in the order they are met """
+
+    def __init__(self):
+        self.symbols = []
+        self._indexes = {}
+
+    def get(self, symbol) -> int:
+        """ Gives the number of a symbol """
+        index = self._indexes.get(symbol)
+        if index is None:
+            index = len(self.symbols)
+            self._indexes[symbol] = index
+            self.symbols.append(symbol)
+        return index
+
+
+class _TableBuilder:
+    """ Builds the parsing tables of a grammar """
+
+    # pylint: disable=too-few-public-methods,too-many-instance-attributes
+    def __init__(self, cfg, canonical: bool):
+        productions = sorted(cfg.productions, key=str)
+        # The added production deriving the start symbol has no head
+        productions.append(Production(None, [cfg.start_symbol]))
+        self.productions = productions
+        self._start = len(productions) - 1
+        self._bodies = [tuple(production.body) for production in productions]
+        self._nullables = cfg.get_nullable_symbols()
+        self._rules = {}
+        for index, production in enumerate(productions[:-1]):
+            self._rules.setdefault(production.head, []).append(index)
+        self._first_sets = self._get_first_sets()
+        # The first terminals of the end of a body, and whether it is
+        # nullable
+        self._first_of_suffix = {}
+        self.actions = []
+        self.gotos = []
+        self.conflicts = []
+        if canonical:
+            states, transitions = self._get_lr_automaton()
+        else:
+            states, transitions = self._get_lalr_automaton()
+        for state, state_transitions in zip(states, transitions):
+            self._add_state(state, state_transitions)
+
+    def _get_first_sets(self) -> Dict[Variable, Set[Terminal]]:
+        """ Gives the terminals starting the words of each variable """
+        first_sets = {head: set() for head in self._rules}
+        is_changing = True
+        while is_changing:
+            is_changing = False
+            for index, body in enumerate(self._bodies[:-1]):
+                first_set = first_sets[self.productions[index].head]
+                length_before = len(first_set)
+                for symbol in body:
+                    if isinstance(symbol, Variable):
+                        first_set |= first_sets.get(symbol, set())
+                    else:
+                        first_set.add(symbol)
+                    if symbol not in self._nullables:
+                        break
+                is_changing |= len(first_set) != length_before
+        return first_sets
+
+    def _get_first_of_suffix(self, production: int, dot: int) \
+            -> Tuple[Set[Terminal], bool]:
+        """ Gives the terminals starting the words of the body of a \
+        production after a dot, and whether this part is nullable """
+        key = (production, dot)
+        result = self._first_of_suffix.get(key)
+        if result is None:
+            first_set = set()
+            for symbol in self._bodies[production][dot:]:
+                if isinstance(symbol, Variable):
+                    first_set |= self._first_sets.get(symbol, set())
+                else:
+                    first_set.add(symbol)
+                if symbol not in self._nullables:
+                    result = (first_set, False)
+                    break
+            else:
+                result = (first_set, True)
+            self._first_of_suffix[key] = result
+        return result
+
+    def _get_closure(self, kernel: Dict[Core, Set[Any]]) \
+            -> Dict[Core, Set[Any]]:
+        """ Adds to items the items predicted by them, with their \
+        lookaheads """
+        items = {core: set(lookaheads) for core, lookaheads in kernel.items()}
+        to_process = list(items)
+        while to_process:
+            production, dot = to_process.pop()
+            body = self._bodies[production]
+            if dot == len(body) or not isinstance(body[dot], Variable):
+                continue
+            first_set, is_nullable = self._get_first_of_suffix(production,
+                                                               dot + 1)
+            lookaheads = first_set
+            if is_nullable:
+                lookaheads = first_set | items[(production, dot)]
+            for predicted in self._rules.get(body[dot], []):
+                core = (predicted, 0)
+                existing = items.get(core)
+                if existing is None:
+                    items[core] = set(lookaheads)
+                    to_process.append(core)
+                elif not lookaheads <= existing:
+                    existing |= lookaheads
+                    to_process.append(core)
+        return items
+
+    def _get_successors(self, items: Dict[Core, Set[Any]]) \
+            -> Dict[Any, Dict[Core, Set[Any]]]:
+        """ Gives the kernels reached by reading each symbol """
+        successors = {}
+        for (production, dot), lookaheads in items.items():
+            body = self._bodies[production]
+            if dot < len(body):
+                kernel = successors.setdefault(body[dot], {})
+                kernel[(production, dot + 1)] = lookaheads
+        return successors
+
+    def _get_lr_automaton(self) \
+            -> Tuple[List[Dict[Core, Set[Any]]], List[Dict[Any, int]]]:
+        """ The states of the LR(1) automaton, and their transitions """
+        start = {(self._start, 0): {_END}}
+        indexes = {_get_kernel_key(start): 0}
+        kernels = [start]
+        states = []
+        transitions = []
+        while len(states) < len(kernels):
+            items = self._get_closure(kernels[len(states)])
+            states.append(items)
+            state_transitions = {}
+            for symbol, kernel in self._get_successors(items).items():
+                key = _get_kernel_key(kernel)
+                index = indexes.get(key)
+                if index is None:
+                    index = len(kernels)
+                    indexes[key] = index
+                    kernels.append(kernel)
+                state_transitions[symbol] = index
+            transitions.append(state_transitions)
+        return states, transitions
+
+    def _get_lalr_automaton(self) \
+            -> Tuple[List[Dict[Core, Set[Any]]], List[Dict[Any, int]]]:
+        """ The states of the LR(0) automaton with the LALR(1) lookaheads, \
+        and their transitions """
+        # pylint: disable=too-many-locals
+        kernels, transitions = self._get_lr0_automaton()
+        # The lookaheads of each kernel item, and the kernel items their
+        # lookaheads propagate to
+        lookaheads = [{core: set() for core in kernel} for kernel in kernels]
+        propagations = {}
+        lookaheads[0][(self._start, 0)].add(_END)
+        for index, kernel in enumerate(kernels):
+            for core in kernel:
+                items = self._get_closure({core: {_PROPAGATED}})
+                for (production, dot), item_lookaheads in items.items():
+                    body = self._bodies[production]
+                    if dot == len(body):
+                        continue
+                    target = transitions[index][body[dot]]
+                    target_core = (production, dot + 1)
+                    for lookahead in item_lookaheads:
+                        if lookahead is _PROPAGATED:
+                            propagations.setdefault((index, core), []) \
+                                .append((target, target_core))
+                        else:
+                            lookaheads[target][target_core].add(lookahead)
+        to_process = [(index, core)
+                      for index, kernel_lookaheads in enumerate(lookaheads)
+                      for core, core_lookaheads in kernel_lookaheads.items()
+                      if core_lookaheads]
+        while to_process:
+            index, core = to_process.pop()
+            source = lookaheads[index][core]
+            for target, target_core in propagations.get((index, core), []):
+                target_lookaheads = lookaheads[target][target_core]
+                if not source <= target_lookaheads:
+                    target_lookaheads |= source
+                    to_process.append((target, target_core))
+        states = [self._get_closure(kernel) for kernel in lookaheads]
+        return states, transitions
+
+    def _get_lr0_automaton(self) \
+            -> Tuple[List[List[Core]], List[Dict[Any, int]]]:
+        """ The kernels of the states of the LR(0) automaton, and their \
+        transitions """
+        start = [(self._start, 0)]
+        indexes = {frozenset(start): 0}
+        kernels = [start]
+        transitions = []
+        while len(transitions) < len(kernels):
+            items = self._get_closure(
+                {core: set() for core in kernels[len(transitions)]})
+            state_transitions = {}
+            for symbol, kernel in self._get_successors(items).items():
+                key = frozenset(kernel)
+                index = indexes.get(key)
+                if index is None:
+                    index = len(kernels)
+                    indexes[key] = index
+                    kernels.append(sorted(kernel))
+                state_transitions[symbol] = index
+            transitions.append(state_transitions)
+        return kernels, transitions
+
+    def _add_state(self, items: Dict[Core, Set[Any]],
+                   transitions: Dict[Any, int]):
+        """ Fills the tables for a state """
+        state = len(self.actions)
+        cells = {}
+        gotos = {}
+        for symbol, target in transitions.items():
+            if isinstance(symbol, Variable):
+                gotos[symbol] = target
+            else:
+                cells[symbol] = [target]
+        for (production, dot), lookaheads in sorted(items.items()):
+            if dot == len(self._bodies[production]):
+                for lookahead in lookaheads:
+                    cells.setdefault(lookahead, []).append(-1 - production)
+        actions = {}
+        for lookahead, cell in cells.items():
+            actions[lookahead] = cell[0]
+            if len(cell) > 1:
+                self.conflicts.append((state, lookahead, cell))
+        self.actions.append(actions)
+        self.gotos.append(gotos)
+
+
+def _get_kernel_key(kernel: Dict[Core, Set[Any]]) -> frozenset:
+    """ A hashable version of a kernel with lookaheads """
+    return frozenset((core, frozenset(lookaheads))
+                     for core, lookaheads in kernel.items())
+
+
+def _get_terminals(word: Iterable[Union[Terminal, str]]) -> Iterable[Any]:
+    """ The terminals of a word, followed by the end of the word """
+    for symbol in word:
+        if symbol != Epsilon():
+            yield to_terminal(symbol)
+    yield _END
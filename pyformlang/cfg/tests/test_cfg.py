@@ -1,8 +1,10 @@
 """ Tests the CFG """
+import itertools
 import string
 
 from pyformlang import pda
-from pyformlang.cfg import Production, Variable, Terminal, CFG, Epsilon
+from pyformlang.cfg import Production, Variable, Terminal, CFG, Epsilon, \
+    CompiledCFG
 from pyformlang.cfg.cyk_table import DerivationDoesNotExist
 from pyformlang.cfg.pda_object_creator import PDAObjectCreator
 from pyformlang.finite_automaton import DeterministicFiniteAutomaton
@@ -924,6 +926,83 @@ class TestCFG:
             assert not cfg.contains(invalid)
             assert not suffix_cfg.contains(invalid)
 
+    def test_cyk_long_word(self):
+        cfg = CFG.from_text("S -> S S | a S b | a b | S c")
+        word = "ab" * 40 + "c" + "aabb" * 20
+        assert cfg.contains(word)
+        assert not cfg.contains(word + "a")
+        assert not cfg.contains("c" + word)
+        parse_tree = cfg.get_cnf_parse_tree(word)
+        assert get_leaves(parse_tree) == list(word)
+        derivation = parse_tree.get_leftmost_derivation()
+        assert derivation[-1] == [Terminal(letter) for letter in word]
+
+    def test_compile(self):
+        cfg = get_sentence_cfg()
+        compiled_cfg = cfg.compile()
+        assert isinstance(compiled_cfg, CompiledCFG)
+        assert cfg.compile() is compiled_cfg
+        assert len(compiled_cfg) == len(cfg.to_normal_form().variables)
+        assert compiled_cfg.start_symbol == Variable("S")
+        for _ in range(100):
+            assert compiled_cfg.contains(
+                "she eats a fish with a fork".split())
+            assert not compiled_cfg.contains("fish eats".split())
+        assert compiled_cfg.contains(["she", Epsilon(), "eats"])
+        assert not compiled_cfg.contains([])
+        assert not compiled_cfg.contains(["unknown"])
+        parse_tree = compiled_cfg.get_cnf_parse_tree(["she", "eats"])
+        assert parse_tree.value == Variable("S")
+        with pytest.raises(DerivationDoesNotExist):
+            compiled_cfg.get_cnf_parse_tree([])
+        assert CFG.from_text("S -> a S | $").compile().contains([])
+
+    def test_valiant(self):
+        cfg = CFG.from_text("""
+            S -> S S | a S b | a b | c
+            """)
+        words = [list(word) for length in range(7)
+                 for word in itertools.product("abc", repeat=length)]
+        for word in words:
+            assert cfg.contains(word, method="valiant") == cfg.contains(word)
+        word = ["a"] * 150 + ["c", "b"] * 75 + ["b"] * 75
+        assert cfg.contains(word, method="valiant")
+        assert cfg.contains(word)
+        assert not cfg.contains(word + ["a"], method="valiant")
+        assert not cfg.contains(["a", "d", "b"], method="valiant")
+        assert not CFG.from_text("S -> a").contains(["a", "a"],
+                                                     method="valiant")
+        with pytest.raises(ValueError):
+            cfg.contains(["a", "b"], method="unknown")
+
+
+def get_sentence_cfg():
+    """ A small ambiguous grammar of English sentences, generating "she \
+    eats a fish with a fork" """
+    return CFG.from_text("""
+        S -> NP VP
+        NP -> Det N | NP PP | she
+        VP -> V NP | VP PP | eats
+        PP -> P NP
+        Det -> the | a
+        N -> fish | fork
+        V -> eats
+        P -> with
+        """)
+
+
+def get_leaves(parse_tree):
+    """ The values of the terminals at the leaves of a parse tree, from \
+    left to right """
+    leaves = []
+    to_process = [parse_tree]
+    while to_process:
+        node = to_process.pop()
+        if not node.sons and isinstance(node.value, Terminal):
+            leaves.append(node.value.value)
+        to_process.extend(reversed(node.sons))
+    return leaves
+
 
 def get_example_text_duplicate():
     """ Duplicate text """
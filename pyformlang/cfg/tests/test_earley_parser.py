@@ -0,0 +1,97 @@
+"""
+Tests for the Earley parser
+"""
+
+import itertools
+
+import pytest
+
+from pyformlang.cfg import CFG, Variable, Terminal, EarleyParser
+from pyformlang.cfg.cyk_table import DerivationDoesNotExist
+from pyformlang.cfg.tests.test_cfg import get_leaves, get_sentence_cfg
+
+
+class TestEarleyParser:
+    """ Tests the Earley parser """
+
+    # pylint: disable=missing-function-docstring
+
+    def test_agrees_with_cyk(self):
+        texts = ["S -> S S | a S b | a b | c",
+                 """S -> A B C
+                    A -> a A | $
+                    B -> b | $ | A B
+                    C -> C c | $""",
+                 """S -> a S | a | B
+                    B -> B b | $ | S""",
+                 """S -> A A A
+                    A -> $ | a | A A"""]
+        for text in texts:
+            cfg = CFG.from_text(text)
+            parser = EarleyParser(cfg)
+            words = [list(word) for length in range(6)
+                     for word in itertools.product("abc", repeat=length)]
+            for word in words:
+                assert parser.parse(word) == cfg.contains(word)
+                assert cfg.contains(word, method="earley") == \
+                    cfg.contains(word)
+
+    def test_parse_tree(self):
+        parser = EarleyParser(get_sentence_cfg())
+        word = "she eats a fish with a fork".split()
+        parse_tree = parser.get_parse_tree(word)
+        assert parse_tree.value == Variable("S")
+        assert [son.value for son in parse_tree.sons] == \
+            [Variable("NP"), Variable("VP")]
+        assert get_leaves(parse_tree) == word
+        assert parse_tree.get_leftmost_derivation()[-1] == \
+            [Terminal(x) for x in word]
+        with pytest.raises(DerivationDoesNotExist):
+            parser.get_parse_tree("she fish".split())
+
+    def test_parse_forest(self):
+        cfg = CFG.from_text("S -> S + S | a")
+        parser = EarleyParser(cfg)
+        forest = parser.get_parse_forest("a")
+        assert forest.value == Variable("S")
+        assert (forest.start, forest.end) == (0, 1)
+        assert not forest.is_ambiguous()
+        assert len(forest.families) == 1
+        assert not parser.get_parse_forest("a+a").is_ambiguous()
+        # The Catalan number of trees, in a polynomial number of nodes
+        forest = parser.get_parse_forest("+".join("a" * 30))
+        assert forest.is_ambiguous()
+        assert len(forest.get_nodes()) < 10000
+        assert get_leaves(forest.get_parse_tree()) == \
+            list("+".join("a" * 30))
+
+    def test_cycles_and_nullables(self):
+        cfg = CFG.from_text("""
+            S -> S | A S B | a
+            A -> $ | A
+            B -> b | $
+            """)
+        parser = EarleyParser(cfg)
+        assert parser.parse("ab")
+        assert parser.parse(["a"])
+        assert not parser.parse([])
+        forest = parser.get_parse_forest("abb")
+        assert forest.is_ambiguous()
+        assert get_leaves(forest.get_parse_tree()) == ["a", "b", "b"]
+        assert EarleyParser(CFG.from_text("S -> A\nA -> $")).parse([])
+
+    def test_long_words(self):
+        right = EarleyParser(CFG.from_text("S -> a S | a"))
+        left = EarleyParser(CFG.from_text("S -> S a | a"))
+        for parser in [right, left]:
+            assert parser.parse("a" * 3000)
+            assert not parser.parse("a" * 3000 + "b")
+        parse_tree = right.get_parse_tree("a" * 3000)
+        assert len(get_leaves(parse_tree)) == 3000
+
+    def test_early_abort(self):
+        parser = EarleyParser(CFG.from_text("S -> a S | b"))
+        assert not parser.parse(["c"] + ["a"] * 100000 + ["b"])
+        assert parser.parse(["a", "b"])
+        assert not parser.parse(["a", "b", "b"])
+        assert not EarleyParser(CFG()).parse([])
@@ -0,0 +1,111 @@
+"""
+Tests for the LR(1) and LALR(1) parsers
+"""
+
+import itertools
+import json
+
+import pytest
+
+from pyformlang.cfg import CFG, Variable, Terminal, LRParser
+from pyformlang.cfg.cfg import NotParsableException
+from pyformlang.cfg.tests.test_cfg import get_leaves
+
+
+def get_expression_cfg():
+    """ Arithmetic expressions """
+    return CFG.from_text("""
+        E -> E + T | T
+        T -> T * F | F
+        F -> ( E ) | a
+        """, start_symbol=Variable("E"))
+
+
+class TestLRParser:
+    """ Tests the LR(1) and LALR(1) parsers """
+
+    # pylint: disable=missing-function-docstring
+
+    def test_expressions(self):
+        cfg = get_expression_cfg()
+        lalr_parser = LRParser(cfg)
+        lr_parser = LRParser(cfg, method="lr")
+        assert len(lalr_parser) == 12
+        assert len(lr_parser) == 22
+        for parser in [lalr_parser, lr_parser]:
+            assert parser.is_parsable()
+            parse_tree = parser.get_parse_tree("a+a*(a+a)")
+            assert parse_tree.value == Variable("E")
+            assert [son.value for son in parse_tree.sons] == \
+                [Variable("E"), Terminal("+"), Variable("T")]
+            assert get_leaves(parse_tree) == list("a+a*(a+a)")
+            assert parser.contains(["a", "*", "a"])
+            assert not parser.contains("a+")
+            assert not parser.contains("a+b")
+            assert not parser.contains([])
+            with pytest.raises(NotParsableException):
+                parser.get_parse_tree("(a")
+        with pytest.raises(ValueError):
+            LRParser(cfg, method="slr")
+
+    def test_agrees_with_cyk(self):
+        texts = ["""S -> A B
+                    A -> a A | $
+                    B -> b B | $""",
+                 "S -> a S b | $",
+                 """S -> L = R | R
+                    L -> * R | a
+                    R -> L""",
+                 """S -> A a | b A c | d c | b d a
+                    A -> d"""]
+        for text in texts:
+            cfg = CFG.from_text(text)
+            parser = LRParser(cfg)
+            assert parser.is_parsable()
+            words = [list(word) for length in range(6)
+                     for word in itertools.product("abcd=*", repeat=length)]
+            for word in words:
+                assert parser.contains(word) == cfg.contains(word)
+
+    def test_conflicts(self):
+        cfg = CFG.from_text("""
+            S -> a A d | b B d | a B e | b A e
+            A -> c
+            B -> c
+            """)
+        conflicts = LRParser(cfg).conflicts
+        assert len(conflicts) == 2
+        assert all(conflict.shift is None for conflict in conflicts)
+        assert {conflict.lookahead for conflict in conflicts} == \
+            {Terminal("d"), Terminal("e")}
+        assert "reduce/reduce" in repr(conflicts[0])
+        with pytest.raises(NotParsableException):
+            LRParser(cfg).get_parse_tree("acd")
+        parser = LRParser(cfg, method="lr")
+        assert parser.is_parsable()
+        assert parser.contains("acd")
+        assert not parser.contains("acc")
+        ambiguous = LRParser(CFG.from_text("S -> S + S | a"))
+        assert not ambiguous.is_parsable()
+        assert ambiguous.conflicts[0].shift is not None
+        with pytest.raises(NotParsableException):
+            ambiguous.contains("a")
+
+    def test_serialization(self):
+        parser = LRParser(get_expression_cfg())
+        tables = json.loads(json.dumps(parser.to_dict()))
+        loaded = LRParser.from_dict(tables)
+        assert len(loaded) == len(parser)
+        word = "(a+a)*a+a"
+        assert get_leaves(loaded.get_parse_tree(word)) == list(word)
+        assert loaded.get_parse_tree(word).get_leftmost_derivation() == \
+            parser.get_parse_tree(word).get_leftmost_derivation()
+        assert not loaded.contains("a++a")
+        conflicting = LRParser.from_dict(
+            LRParser(CFG.from_text("S -> S S | a")).to_dict())
+        assert not conflicting.is_parsable()
+
+    def test_long_word(self):
+        parser = LRParser(get_expression_cfg())
+        word = "a" + "+a*(a+a)" * 2000
+        assert get_leaves(parser.get_parse_tree(word)) == list(word)
@@ -0,0 +1,179 @@
+"""
+Recognition of a word by boolean matrix multiplication, following Valiant
+"""
+
+from typing import List, Tuple
+
+import numpy as np
+
+# The largest number of cells of a block of the table filled cell by cell
+BLOCK_SIZE = 128 * 128
+
+
+class ValiantTable:
+    """
+    A CYK table filled with boolean matrix products
+
+    This is the algorithm of Valiant, as reformulated by Okhotin. For each \
+    variable A, the table holds the boolean matrix of the factors of the \
+    word generated by A. The upper triangle of the table is divided \
+    recursively into blocks. A block is completed by first completing the \
+    part of it closest to the diagonal, and by adding to the others the \
+    products of the matrices of the variables of each binary body, \
+    computed with numpy. The small blocks are filled one diagonal at a \
+    time. With a subcubic matrix multiplication, the recognition is \
+    subcubic as well.
+
+    The table holds a matrix per variable and per binary body of the \
+    normal form, with a cell per pair of positions in the word, so it \
+    needs a memory quadratic in the length of the word.
+
+    Parameters
+    ----------
+    compiled_cfg : :class:`~pyformlang.cfg.compiled_cfg.CompiledCFG`
+        The compiled grammar
+    word : list of Terminals
+        The word to recognize, not empty
+    """
+
+    # pylint: disable=too-few-public-methods,too-many-instance-attributes
+    def __init__(self, compiled_cfg, word):
+        self._compiled_cfg = compiled_cfg
+        self._word = word
+        bodies = compiled_cfg.get_binary_bodies()
+        self._lefts = np.array([left for left, _, _ in bodies], dtype=int)
+        self._rights = np.array([right for _, right, _ in bodies],
+                                dtype=int)
+        # For each variable, the bodies it produces
+        self._heads = np.zeros((len(compiled_cfg), len(bodies)),
+                               dtype=np.float32)
+        for index, (_, _, heads) in enumerate(bodies):
+            for head in _get_bits(heads):
+                self._heads[head, index] = 1
+        size = len(word) + 1
+        # self._table[A, i, j] tells whether A generates the factor from i
+        # to j
+        self._table = np.zeros((len(compiled_cfg), size, size), dtype=bool)
+        # self._pairs[r, i, j] tells whether the factor from i to j is the
+        # concatenation of factors generated by the variables of the body r
+        self._pairs = np.zeros((len(bodies), size, size), dtype=bool)
+        self._is_complete = True
+        for i, terminal in enumerate(word):
+            heads = compiled_cfg.get_terminal_heads(terminal)
+            if not heads:
+                self._is_complete = False
+            self._table[_get_bits(heads), i, i + 1] = True
+        if self._is_complete and bodies:
+            self._compute(0, size)
+
+    def generate_word(self) -> bool:
+        """
+        Checks is the word is generated
+
+        Returns
+        -------
+        is_generated : bool
+        """
+        start = self._compiled_cfg.start_index
+        return self._is_complete and start is not None and \
+            bool(self._table[start, 0, len(self._word)])
+
+    def _compute(self, start: int, end: int):
+        """ Fills the table for the factors between start and end """
+        if end - start <= 2:
+            return
+        middle = (start + end) // 2
+        self._compute(start, middle)
+        self._compute(middle, end)
+        self._complete(start, middle, middle, end)
+
+    def _complete(self, row_start: int, row_end: int, column_start: int,
+                  column_end: int):
+        """ Fills a block of the table, knowing the factors inside the rows \
+        and inside the columns, and the pairs splitting a factor of the \
+        block between the rows and the columns """
+        n_rows = row_end - row_start
+        n_columns = column_end - column_start
+        if n_rows * n_columns <= BLOCK_SIZE:
+            self._complete_by_diagonals(row_start, row_end, column_start,
+                                        column_end)
+            return
+        rows = (row_start, row_end)
+        columns = (column_start, column_end)
+        top = (row_start, (row_start + row_end) // 2)
+        bottom = (top[1], row_end)
+        left = (column_start, (column_start + column_end) // 2)
+        right = (left[1], column_end)
+        if n_columns == 1 or (n_rows > 1 and n_rows >= 2 * n_columns):
+            self._complete(*bottom, *columns)
+            self._multiply(top, bottom, columns)
+            self._complete(*top, *columns)
+        elif n_rows == 1 or n_columns >= 2 * n_rows:
+            self._complete(*rows, *left)
+            self._multiply(rows, left, right)
+            self._complete(*rows, *right)
+        else:
+            self._complete(*bottom, *left)
+            self._multiply(top, bottom, left)
+            self._complete(*top, *left)
+            self._multiply(bottom, left, right)
+            self._complete(*bottom, *right)
+            self._multiply(top, bottom, right)
+            self._multiply(top, left, right)
+            self._complete(*top, *right)
+
+    def _multiply(self, rows: Tuple[int, int], middle: Tuple[int, int],
+                  columns: Tuple[int, int]):
+        """ Adds the pairs splitting the factors from the rows to the \
+        columns in the middle, each range being a start and an end """
+        lefts = self._table[self._lefts, rows[0]:rows[1],
+                            middle[0]:middle[1]].astype(np.float32)
+        rights = self._table[self._rights, middle[0]:middle[1],
+                             columns[0]:columns[1]].astype(np.float32)
+        self._pairs[:, rows[0]:rows[1], columns[0]:columns[1]] |= \
+            np.matmul(lefts, rights) > 0
+
+    def _complete_by_diagonals(self, row_start: int, row_end: int,
+                               column_start: int, column_end: int):
+        """ Fills a small block of the table cell by cell, the factors of \
+        a same length at once """
+        # pylint: disable=too-many-locals
+        n_rows = row_end - row_start
+        block = self._table[:, row_start:row_end, column_start:column_end]
+        block_pairs = self._pairs[:, row_start:row_end,
+                                  column_start:column_end]
+        # The factors of the block split inside the rows or inside the
+        # columns. The other factors of the rows and of the columns are
+        # empty in the table.
+        inner = np.concatenate((np.arange(row_start, row_end),
+                                np.arange(column_start, column_end)))
+        # For each body, the first variable from the rows to the inner
+        # positions, and the second one from the inner positions to the
+        # columns, transposed
+        lefts = self._table[np.ix_(self._lefts,
+                                   np.arange(row_start, row_end), inner)]
+        rights = self._table[np.ix_(self._rights, inner,
+                                    np.arange(column_start, column_end))] \
+            .transpose(0, 2, 1).copy()
+        for length in range(column_start - row_end + 1,
+                            column_end - row_start):
+            rows = np.arange(max(0, column_start - length - row_start),
+                             min(n_rows, column_end - length - row_start))
+            columns = rows + (row_start + length - column_start)
+            pairs = block_pairs[:, rows, columns] | np.any(
+                lefts[:, rows[0]:rows[-1] + 1]
+                & rights[:, columns[0]:columns[-1] + 1], axis=2)
+            heads = np.matmul(self._heads, pairs.astype(np.float32)) > 0
+            block[:, rows, columns] |= heads
+            lefts[:, rows, n_rows + columns] |= heads[self._lefts]
+            rights[:, columns, rows] |= heads[self._rights]
+
+
+def _get_bits(mask: int) -> List[int]:
+    """ The positions of the bits set in a mask """
+    bits = []
+    while mask:
+        lowest = mask & -mask
+        bits.append(lowest.bit_length() - 1)
+        mask ^= lowest
+    return bits
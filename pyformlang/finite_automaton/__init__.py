@@ -15,6 +15,14 @@ Available Classes
     A non-deterministic finite automaton, without epsilon transitions
 :class:`~pyformlang.finite_automaton.EpsilonNFA`
     A non-deterministic finite automaton, with epsilon transitions
+:class:`~pyformlang.finite_automaton.CompiledDFA`
+    A frozen deterministic automaton with integer states, for fast matching
+:class:`~pyformlang.finite_automaton.LazyDFA`
+    A deterministic automaton built on demand from an epsilon NFA
+:class:`~pyformlang.finite_automaton.Matcher`
+    Reads a word one symbol at a time, for streams
+:class:`~pyformlang.finite_automaton.LazyIntersection`
+    An intersection of automata whose product is explored on demand
 :class:`~pyformlang.finite_automaton.TransitionFunction`
     A deterministic transition function
 :class:`~pyformlang.finite_automaton.NondeterministicTransitionFunction`
@@ -38,6 +46,10 @@ from .finite_automaton import FiniteAutomaton
 from .deterministic_finite_automaton import DeterministicFiniteAutomaton
 from .nondeterministic_finite_automaton import NondeterministicFiniteAutomaton
 from .epsilon_nfa import EpsilonNFA
+from .compiled_dfa import CompiledDFA
+from .lazy_dfa import LazyDFA
+from .matcher import Matcher
+from .lazy_intersection import LazyIntersection
 from .state import State
 from .symbol import Symbol
 from .epsilon import Epsilon
@@ -51,6 +63,10 @@ __all__ = ["FiniteAutomaton",
            "DeterministicFiniteAutomaton",
            "NondeterministicFiniteAutomaton",
            "EpsilonNFA",
+           "CompiledDFA",
+           "LazyDFA",
+           "Matcher",
+           "LazyIntersection",
            "State",
            "Symbol",
            "Epsilon",
@@ -0,0 +1,315 @@
+"""
+A bit-parallel representation of a nondeterministic automaton, used to
+simulate it efficiently
+"""
+
+from typing import Iterable, Any, Dict, List, Optional
+
+from .epsilon import Epsilon
+from .state import State
+from .symbol import Symbol
+from .finite_automaton import to_symbol
+
+
+class BitsetNFA:
+    """ A frozen representation of an epsilon NFA where sets of states are \
+    integers used as bitsets.
+
+    The states are numbered once. The epsilon closures are precomputed as \
+    bitmasks and folded into the successor masks, so that a step of the \
+    simulation only ORs the successor masks of the active states having \
+    an outgoing transition on the read symbol. The sets of states \
+    manipulated are always closed under epsilon transitions.
+
+    It does not follow later modifications of the automaton it was built \
+    from.
+
+    Parameters
+    ----------
+    enfa : :class:`~pyformlang.finite_automaton.EpsilonNFA`
+        The automaton to represent
+    """
+
+    # pylint: disable=too-many-instance-attributes
+    def __init__(self, enfa):
+        self._states = list(enfa.states)
+        self._indexes = {state: index
+                         for index, state in enumerate(self._states)}
+        # The transition function may mention states unknown to the automaton
+        for s_from, _, s_to in enfa:
+            for state in (s_from, s_to):
+                if state not in self._indexes:
+                    self._indexes[state] = len(self._states)
+                    self._states.append(state)
+        # The states of a same strongly connected component share the same
+        # closure object
+        masks = {}
+        closures = []
+        for state in self._states:
+            # pylint: disable=protected-access
+            closure = enfa._get_closure(state)
+            mask = masks.get(closure)
+            if mask is None:
+                mask = self._to_mask(closure)
+                masks[closure] = mask
+            closures.append(mask)
+        self._closures = closures
+        successors = {}
+        self._symbols = {}
+        # For each state, the closed successors by symbol
+        self._outgoing = [{} for _ in self._states]
+        for s_from, symbol, s_to in enfa:
+            if symbol == Epsilon():
+                continue
+            i_from = self._indexes[s_from]
+            self._symbols[symbol.value] = symbol
+            masks = successors.setdefault(symbol.value, {})
+            masks[i_from] = masks.get(i_from, 0) | closures[
+                self._indexes[s_to]]
+            self._outgoing[i_from][symbol.value] = masks[i_from]
+        # For each symbol, the states having a transition on it and their
+        # closed successors
+        self._successors = {value: (self._to_mask(
+                                [self._states[i] for i in masks]), masks)
+                            for value, masks in successors.items()}
+        start = 0
+        for state in enfa.start_states:
+            start |= closures[self._indexes[state]]
+        self._start = start
+        self._finals = self._to_mask(enfa.final_states)
+        self._minterms: Optional[List[List[Any]]] = None
+        self._minterm_outgoing: List[Dict[int, int]] = []
+
+    def __len__(self):
+        """ The number of states """
+        return len(self._states)
+
+    def _to_mask(self, states: Iterable[Any]) -> int:
+        mask = 0
+        for state in states:
+            mask |= 1 << self._indexes[state]
+        return mask
+
+    @property
+    def start_mask(self) -> int:
+        """ The set of states reached before reading anything """
+        return self._start
+
+    @property
+    def final_mask(self) -> int:
+        """ The set of final states """
+        return self._finals
+
+    def get_index(self, state: Any) -> int:
+        """ Gives the bit of a state """
+        return self._indexes[state]
+
+    def get_state(self, index: int) -> State:
+        """ Gives the state of a bit """
+        return self._states[index]
+
+    def get_states(self, mask: int) -> set:
+        """ Gives the states represented by a mask
+
+        Parameters
+        ----------
+        mask : int
+            A set of states, as a bitset
+
+        Returns
+        ----------
+        states : set of :class:`~pyformlang.finite_automaton.State`
+            The states
+        """
+        return {self._states[index] for index in iterate_bits(mask)}
+
+    def get_closure_mask(self, state: Any) -> int:
+        """ Gives the epsilon closure of a state, as a bitset """
+        return self._closures[self._indexes[state]]
+
+    def get_symbols(self) -> Iterable[Any]:
+        """ Gives the values of the symbols having a transition """
+        return self._successors.keys()
+
+    def get_symbol(self, value: Any) -> Symbol:
+        """ Gives the symbol of a given value """
+        return self._symbols[value]
+
+    def has_symbol(self, value: Any) -> bool:
+        """ Whether a symbol, or its value, has a transition """
+        return value in self._successors
+
+    def get_symbols_from(self, mask: int) -> Iterable[Any]:
+        """ Gives the values of the symbols leaving a set of states """
+        return self.get_successors(mask).keys()
+
+    def get_state_successors(self, index: int) -> Dict[Any, int]:
+        """ Gives the closed successors of a single state, by symbol value
+
+        Parameters
+        ----------
+        index : int
+            The bit of the state
+
+        Returns
+        ----------
+        successors : dict of any to int
+            For each value of symbol leaving the state, the next set of \
+            states. It must not be modified.
+        """
+        return self._outgoing[index]
+
+    def get_successors(self, mask: int) -> Dict[Any, int]:
+        """ Reads all the possible symbols from a set of states at once
+
+        Only the symbols actually leaving the set of states are considered.
+
+        Parameters
+        ----------
+        mask : int
+            The current set of states, as a bitset closed under epsilon \
+            transitions
+
+        Returns
+        ----------
+        successors : dict of any to int
+            For each value of symbol leaving the set, the next set of \
+            states
+        """
+        successors = {}
+        outgoing = self._outgoing
+        while mask:
+            lowest = mask & -mask
+            for value, next_mask in outgoing[lowest.bit_length() - 1].items():
+                successors[value] = successors.get(value, 0) | next_mask
+            mask ^= lowest
+        return successors
+
+    def get_minterms(self) -> List[List[Any]]:
+        """ Groups the symbols having exactly the same transitions
+
+        The symbols of a same minterm cannot be distinguished by the \
+        automaton, for example the characters of a character class, so the \
+        sets of states only need to be computed once per minterm.
+
+        Returns
+        ----------
+        minterms : list of list of any
+            The values of the symbols, grouped by minterm
+        """
+        if self._minterms is None:
+            minterms = {}
+            for value, (_, masks) in self._successors.items():
+                minterms.setdefault(frozenset(masks.items()), []).append(
+                    value)
+            self._minterms = list(minterms.values())
+            minterm_indexes = {value: index
+                               for index, minterm in enumerate(self._minterms)
+                               for value in minterm}
+            self._minterm_outgoing = [
+                {minterm_indexes[value]: next_mask
+                 for value, next_mask in outgoing.items()}
+                for outgoing in self._outgoing]
+        return self._minterms
+
+    def get_minterm_successors(self, mask: int) -> Dict[int, int]:
+        """ Reads all the possible minterms from a set of states at once
+
+        Parameters
+        ----------
+        mask : int
+            The current set of states, as a bitset closed under epsilon \
+            transitions
+
+        Returns
+        ----------
+        successors : dict of int to int
+            For each index of minterm leaving the set, as given by \
+            get_minterms, the next set of states
+        """
+        self.get_minterms()
+        successors = {}
+        outgoing = self._minterm_outgoing
+        while mask:
+            lowest = mask & -mask
+            for minterm, next_mask in outgoing[lowest.bit_length() - 1] \
+                    .items():
+                successors[minterm] = successors.get(minterm, 0) | next_mask
+            mask ^= lowest
+        return successors
+
+    def step(self, mask: int, symbol: Any) -> int:
+        """ Reads a symbol from a set of states
+
+        Parameters
+        ----------
+        mask : int
+            The current set of states, as a bitset closed under epsilon \
+            transitions
+        symbol : any
+            The value of the symbol to read, which must not be epsilon
+
+        Returns
+        ----------
+        mask : int
+            The next set of states, closed under epsilon transitions
+        """
+        successors = self._successors.get(symbol)
+        if successors is None:
+            return 0
+        sources, masks = successors
+        to_process = mask & sources
+        next_mask = 0
+        while to_process:
+            lowest = to_process & -to_process
+            next_mask |= masks[lowest.bit_length() - 1]
+            to_process ^= lowest
+        return next_mask
+
+    def is_final_mask(self, mask: int) -> bool:
+        """ Whether a set of states contains a final state """
+        return (mask & self._finals) != 0
+
+    def accepts(self, word: Iterable[Any], skip_epsilon: bool = True) \
+            -> bool:
+        """ Checks whether the automaton accepts a given word
+
+        Parameters
+        ----------
+        word : iterable of any
+            A sequence of symbols, or of their values
+        skip_epsilon : bool, optional
+            Whether epsilon symbols in the word are ignored (default) or \
+            make the word rejected
+
+        Returns
+        ----------
+        is_accepted : bool
+            Whether the word is accepted or not
+        """
+        all_successors = self._successors
+        current = self._start
+        for symbol in word:
+            successors = all_successors.get(symbol)
+            if successors is None:
+                if skip_epsilon and to_symbol(symbol) == Epsilon():
+                    continue
+                return False
+            sources, masks = successors
+            to_process = current & sources
+            current = 0
+            while to_process:
+                lowest = to_process & -to_process
+                current |= masks[lowest.bit_length() - 1]
+                to_process ^= lowest
+            if not current:
+                return False
+        return (current & self._finals) != 0
+
+
+def iterate_bits(mask: int) -> Iterable[int]:
+    """ Gives the positions of the bits set in a mask """
+    while mask:
+        lowest = mask & -mask
+        yield lowest.bit_length() - 1
+        mask ^= lowest
@@ -0,0 +1,219 @@
+"""
+A frozen, integer-indexed representation of a deterministic automaton
+"""
+
+from typing import Iterable, List, Any
+
+import numpy as np
+
+
+class CompiledDFA:
+    """ A frozen version of a deterministic finite automaton, meant to be \
+    reused for many membership queries.
+
+    The states are numbered from 0 and the symbols are interned into the \
+    columns of a dense transition table. Two additional rows and columns \
+    are reserved: a dead state (reached on missing transitions), a column \
+    for unknown symbols (always leading to the dead state) and a padding \
+    column (leaving every state unchanged), used to run words of \
+    different lengths at once in :meth:`match_many`.
+
+    The compiled automaton does not follow later modifications of the \
+    automaton it was built from.
+
+    Parameters
+    ----------
+    dfa : :class:`~pyformlang.finite_automaton.DeterministicFiniteAutomaton`
+        The automaton to compile
+
+    Examples
+    --------
+
+    >>> dfa = DeterministicFiniteAutomaton()
+    >>> dfa.add_transitions([(0, "a", 1), (1, "b", 0)])
+    >>> dfa.add_start_state(0)
+    >>> dfa.add_final_state(1)
+    >>> compiled = dfa.compile()
+    >>> compiled.accepts(["a", "b", "a"])
+    True
+    >>> compiled.match_many([["a"], ["b"], []])
+    [True, False, False]
+
+    """
+
+    # pylint: disable=too-many-instance-attributes
+    def __init__(self, dfa):
+        self._states = list(dfa.states)
+        indexes = {}
+        for index, state in enumerate(self._states):
+            state.index = index
+            indexes[state] = index
+        self._symbols = list(dfa.symbols)
+        self._columns = {symbol.value: index
+                         for index, symbol in enumerate(self._symbols)}
+        n_states = len(self._states)
+        n_symbols = len(self._symbols)
+        self._dead = n_states
+        self._unknown_column = n_symbols
+        self._padding_column = n_symbols + 1
+        self._width = n_symbols + 2
+        table = np.full((n_states + 1, self._width), self._dead,
+                        dtype=np.int64)
+        table[:, self._padding_column] = np.arange(n_states + 1)
+        for s_from, symbol, s_to in dfa:
+            table[indexes[s_from], self._columns[symbol.value]] = \
+                indexes[s_to]
+        table.flags.writeable = False
+        self._table = table
+        finals = np.zeros(n_states + 1, dtype=bool)
+        for state in dfa.final_states:
+            finals[indexes[state]] = True
+        finals.flags.writeable = False
+        self._finals = finals
+        self._start = self._dead
+        if dfa.start_states:
+            self._start = indexes[dfa.start_state]
+        # Python lists are much faster than numpy for scalar accesses
+        self._flat_table = table.ravel().tolist()
+        self._flat_finals = finals.tolist()
+
+    @property
+    def transition_table(self) -> np.ndarray:
+        """ The dense (read-only) transition table, indexed by state ids \
+        and symbol columns """
+        return self._table
+
+    @property
+    def final_table(self) -> np.ndarray:
+        """ A (read-only) boolean array telling which state ids are final """
+        return self._finals
+
+    @property
+    def start_index(self) -> int:
+        """ The id of the start state """
+        return self._start
+
+    @property
+    def dead_index(self) -> int:
+        """ The id of the dead state """
+        return self._dead
+
+    def get_state(self, index: int):
+        """ Gives the state corresponding to an id
+
+        Parameters
+        ----------
+        index : int
+            The id of the state
+
+        Returns
+        ----------
+        state : :class:`~pyformlang.finite_automaton.State` or None
+            The state, None for the dead state
+        """
+        if index == self._dead:
+            return None
+        return self._states[index]
+
+    def get_column(self, symbol: Any) -> int:
+        """ Gives the column of a symbol in the transition table
+
+        Parameters
+        ----------
+        symbol : any
+            The symbol or its value
+
+        Returns
+        ----------
+        column : int
+            The column of the symbol, the one of unknown symbols if it is \
+            not part of the alphabet
+        """
+        return self._columns.get(symbol, self._unknown_column)
+
+    def get_next_index(self, index: int, symbol: Any) -> int:
+        """ Gives the id of the next state
+
+        Parameters
+        ----------
+        index : int
+            The id of the source state
+        symbol : any
+            The symbol read, or its value
+
+        Returns
+        ----------
+        index : int
+            The id of the destination state
+        """
+        return self._flat_table[
+            index * self._width
+            + self._columns.get(symbol, self._unknown_column)]
+
+    def is_final_index(self, index: int) -> bool:
+        """ Whether the state of the given id is final """
+        return self._flat_finals[index]
+
+    def accepts(self, word: Iterable[Any]) -> bool:
+        """ Checks whether the automaton accepts a given word
+
+        Parameters
+        ----------
+        word : iterable of any
+            A sequence of symbols, or of their values
+
+        Returns
+        ----------
+        is_accepted : bool
+            Whether the word is accepted or not
+        """
+        flat_table = self._flat_table
+        columns = self._columns
+        width = self._width
+        unknown = self._unknown_column
+        dead = self._dead
+        current = self._start
+        for symbol in word:
+            if current == dead:
+                return False
+            current = flat_table[current * width
+                                 + columns.get(symbol, unknown)]
+        return self._flat_finals[current]
+
+    def match_many(self, words: Iterable[Iterable[Any]]) -> List[bool]:
+        """ Checks the membership of several words at once
+
+        All words are run simultaneously on the transition table, one \
+        position at a time.
+
+        Parameters
+        ----------
+        words : iterable of iterable of any
+            The words to check
+
+        Returns
+        ----------
+        are_accepted : list of bool
+            For each word, whether it is accepted or not
+        """
+        encoded = [self._encode(word) for word in words]
+        if not encoded:
+            return []
+        max_length = max(len(word) for word in encoded)
+        columns = np.full((len(encoded), max_length), self._padding_column,
+                          dtype=np.int64)
+        for i, word in enumerate(encoded):
+            columns[i, :len(word)] = word
+        current = np.full(len(encoded), self._start, dtype=np.int64)
+        for position in range(max_length):
+            current = self._table[current, columns[:, position]]
+        return self._finals[current].tolist()
+
+    def _encode(self, word: Iterable[Any]) -> List[int]:
+        columns = self._columns
+        unknown = self._unknown_column
+        return [columns.get(symbol, unknown) for symbol in word]
+
+    def __len__(self):
+        """ The number of states, without the dead one """
+        return self._dead
@@ -2,10 +2,13 @@
 Representation of a deterministic finite automaton
 """
 
-from typing import AbstractSet, Iterable, Any
+from typing import AbstractSet, Iterable, Any, List, Optional
 
 import numpy as np
 
+from .compiled_dfa import CompiledDFA
+from .matcher import Matcher, CompiledMatcher
+from .equivalence import get_dfa_counterexample
 # pylint: disable=cyclic-import
 from .epsilon_nfa import to_single_state
 from .finite_automaton import to_state, to_symbol
@@ -13,6 +16,7 @@ from .hopcroft_processing_list import HopcroftProcessingList
 # pylint: disable=cyclic-import
 from .nondeterministic_finite_automaton import NondeterministicFiniteAutomaton
 from .partition import Partition
+from .refinable_partition import RefinablePartition
 from .state import State
 from .symbol import Symbol
 from .transition_function import TransitionFunction
@@ -48,6 +52,31 @@ class PreviousTransitions:
         return self._conversion[i_next0, i_symbol] or []
 
 
+class IntegerTransitions:  # pylint: disable=too-few-public-methods
+    """ The transitions of a deterministic automaton, where states and \
+    symbols are numbered
+
+    For internal usage.
+
+    Parameters
+    ----------
+    states : list of :class:`~pyformlang.finite_automaton.State`
+        The states, indexed by their number
+    finals : list of int
+        The final states
+    symbols : list of :class:`~pyformlang.finite_automaton.Symbol`
+        The symbols, indexed by their number
+    """
+
+    def __init__(self, states, finals, symbols):
+        self.states = states
+        self.finals = finals
+        self.symbols = symbols
+        self.sources = []
+        self.labels = []
+        self.targets = []
+
+
 class DeterministicFiniteAutomaton(NondeterministicFiniteAutomaton):
     """ Represents a deterministic finite automaton
 
@@ -141,6 +170,7 @@ class DeterministicFiniteAutomaton(NondeterministicFiniteAutomaton):
         state = to_state(state)
         self._start_state = {state}
         self._states.add(state)
+        self._clear_cache()
         return 1
 
     def remove_start_state(self, state: Any) -> int:
@@ -167,6 +197,7 @@ class DeterministicFiniteAutomaton(NondeterministicFiniteAutomaton):
         state = to_state(state)
         if {state} == self._start_state:
             self._start_state = {}
+            self._clear_cache()
             return 1
         return 0
 
@@ -208,6 +239,67 @@ class DeterministicFiniteAutomaton(NondeterministicFiniteAutomaton):
                 current_state = None
         return current_state is not None and self.is_final_state(current_state)
 
+    def compile(self) -> CompiledDFA:
+        """ Freezes the dfa into an integer-indexed transition table
+
+        The result is meant to be reused for many membership queries. It \
+        does not follow later modifications of the current automaton. The \
+        index of each state is stored in its index attribute.
+
+        Returns
+        ----------
+        compiled_dfa : :class:`~pyformlang.finite_automaton.CompiledDFA`
+            The compiled automaton
+
+        Examples
+        --------
+
+        >>> dfa = DeterministicFiniteAutomaton()
+        >>> dfa.add_transitions([(0, "abc", 1), (0, "d", 1)])
+        >>> dfa.add_start_state(0)
+        >>> dfa.add_final_state(1)
+        >>> compiled_dfa = dfa.compile()
+        >>> compiled_dfa.accepts(["abc"])
+        True
+
+        """
+        return CompiledDFA(self)
+
+    def matcher(self) -> Matcher:
+        """ Gives a matcher reading words one symbol at a time, for \
+        streams of symbols
+
+        The automaton is compiled, and the current state of the matcher is \
+        an index in the transition table. The matcher is dead when its \
+        state cannot reach a final state.
+
+        Returns
+        ----------
+        matcher : :class:`~pyformlang.finite_automaton.Matcher`
+            A matcher at the start of the automaton
+
+        Examples
+        --------
+
+        >>> dfa = DeterministicFiniteAutomaton()
+        >>> dfa.add_transitions([(0, "a", 1), (1, "b", 0), (1, "c", 2)])
+        >>> dfa.add_start_state(0)
+        >>> dfa.add_final_state(1)
+        >>> matcher = dfa.matcher()
+        >>> matcher.feed("a")
+        True
+        >>> matcher.is_accepting()
+        True
+        >>> matcher.feed("c")
+        False
+
+        """
+        compiled_dfa = self.compile()
+        leading_to_final = self._get_states_leading_to_final()
+        useful = [compiled_dfa.get_state(index) in leading_to_final
+                  for index in range(len(compiled_dfa) + 1)]
+        return CompiledMatcher(compiled_dfa, useful)
+
     def is_deterministic(self) -> bool:
         """ Checks whether an automaton is deterministic
 
@@ -273,41 +365,57 @@ class DeterministicFiniteAutomaton(NondeterministicFiniteAutomaton):
             dfa.add_start_state(list(self._start_state)[0])
         for final in self._final_states:
             dfa.add_final_state(final)
-        for state in self._states:
-            for symbol in self._input_symbols:
-                state_to = self._transition_function(state, symbol)
-                if state_to:
-                    state_to = state_to[0]
-                else:
-                    state_to = None
-                if state_to is not None:
-                    dfa.add_transition(state, symbol, state_to)
+        for state, symbol, state_to in self._transition_function.get_edges():
+            dfa.add_transition(state, symbol, state_to)
         return dfa
 
     def _get_previous_transitions(self):
         previous_transitions = PreviousTransitions(self._states,
                                                    self._input_symbols)
         for state in self._states:
-            for symbol in self._input_symbols:
-                next0 = self._transition_function(state, symbol)
-                if next0:
-                    next0 = next0[0]
-                else:
-                    next0 = None
-                previous_transitions.add(next0, symbol, state)
+            for symbol, previous in \
+                    self._transition_function.get_transitions_to(state):
+                previous_transitions.add(state, symbol, previous)
+            # The missing transitions go to the trash state None
+            symbols = self._transition_function.get_symbols_from(state)
+            if len(symbols) < len(self._input_symbols):
+                for symbol in self._input_symbols:
+                    if symbol not in symbols:
+                        previous_transitions.add(None, symbol, state)
         for symbol in self._input_symbols:
             previous_transitions.add(None, symbol, None)
         return previous_transitions
 
-    def minimize(self) -> "DeterministicFiniteAutomaton":
+    def minimize(self, method: str = "hopcroft") \
+            -> "DeterministicFiniteAutomaton":
         """ Minimize the current DFA
 
+        Parameters
+        ----------
+        method : str, optional
+            The minimization algorithm:
+
+            * "hopcroft" (default): Hopcroft's algorithm on integer arrays, \
+            in O(n.k.log(n)) for n states and k symbols. The states which \
+            are not reachable or cannot lead to a final state are removed.
+            * "valmari": the algorithm of Valmari and Lehtinen for partial \
+            DFAs, in O(m.log(n)) for m transitions. It gives the same \
+            result as "hopcroft" and is faster when the states have few \
+            outgoing transitions compared to the size of the alphabet.
+            * "legacy": the previous implementation, which keeps the \
+            reachable states leading nowhere as a trash state
+
         Returns
         ----------
         dfa :  :class:`~pyformlang.deterministic_finite_automaton\
         .DeterministicFiniteAutomaton`
             The minimal DFA
 
+        Raises
+        ----------
+        ValueError
+            If the method is unknown
+
         Examples
         --------
 
@@ -320,10 +428,243 @@ class DeterministicFiniteAutomaton(NondeterministicFiniteAutomaton):
         True
 
         """
+        if method not in ("hopcroft", "valmari", "legacy"):
+            raise ValueError("Unknown minimization method: " + str(method))
         if not self._start_state or not self._final_states:
-            res = DeterministicFiniteAutomaton()
-            res.add_start_state(State("Empty"))
-            return res
+            return self._get_empty_minimal()
+        if method == "legacy":
+            return self._minimize_legacy()
+        useful = self._get_useful_transitions()
+        if useful is None:
+            return self._get_empty_minimal()
+        if method == "valmari":
+            partition = self._get_partition_valmari(useful)
+        else:
+            partition = self._get_partition_hopcroft(useful)
+        return self._get_quotient(useful, partition)
+
+    @staticmethod
+    def _get_empty_minimal() -> "DeterministicFiniteAutomaton":
+        res = DeterministicFiniteAutomaton()
+        res.add_start_state(State("Empty"))
+        return res
+
+    # pylint: disable=too-many-locals, too-many-branches
+    def _get_useful_transitions(self) -> "IntegerTransitions":
+        """ Numbers the useful states, the ones both reachable and leading \
+        to a final state, and gives the transitions between them
+
+        Returns
+        ----------
+        transitions : :class:`IntegerTransitions` or None
+            The integer transitions, the start state being 0. None if the \
+            start state is not useful.
+        """
+        start = self.start_state
+        states = [start]
+        indexes = {start: 0}
+        symbols = []
+        symbol_indexes = {}
+        sources = []
+        labels = []
+        targets = []
+        previous = [[]]
+        current = 0
+        while current < len(states):
+            for symbol, next_state in \
+                    self._transition_function.get_transitions_from(
+                        states[current]):
+                target = indexes.get(next_state)
+                if target is None:
+                    target = len(states)
+                    indexes[next_state] = target
+                    states.append(next_state)
+                    previous.append([])
+                label = symbol_indexes.get(symbol)
+                if label is None:
+                    label = len(symbols)
+                    symbol_indexes[symbol] = label
+                    symbols.append(symbol)
+                sources.append(current)
+                labels.append(label)
+                targets.append(target)
+                previous[target].append(current)
+            current += 1
+        useful = [False] * len(states)
+        to_process = [index for index, state in enumerate(states)
+                      if state in self._final_states]
+        for index in to_process:
+            useful[index] = True
+        while to_process:
+            for source in previous[to_process.pop()]:
+                if not useful[source]:
+                    useful[source] = True
+                    to_process.append(source)
+        if not useful[0]:
+            return None
+        renumbering = [0] * len(states)
+        useful_states = []
+        for index, state in enumerate(states):
+            if useful[index]:
+                renumbering[index] = len(useful_states)
+                useful_states.append(state)
+        transitions = IntegerTransitions(
+            useful_states,
+            [renumbering[indexes[state]]
+             for state in self._final_states if state in indexes
+             and useful[indexes[state]]],
+            symbols)
+        for source, label, target in zip(sources, labels, targets):
+            if useful[source] and useful[target]:
+                transitions.sources.append(renumbering[source])
+                transitions.labels.append(label)
+                transitions.targets.append(renumbering[target])
+        return transitions
+
+    # pylint: disable=too-many-locals
+    @staticmethod
+    def _get_partition_hopcroft(transitions: "IntegerTransitions") \
+            -> RefinablePartition:
+        """ Groups the equivalent states with Hopcroft's algorithm
+
+        The automaton is completed with a trash state, numbered after the \
+        other states. The predecessors are stored as a CSR structure \
+        indexed by target and symbol.
+
+        Parameters
+        ----------
+        transitions : :class:`IntegerTransitions`
+            The transitions of an automaton without useless states
+
+        Returns
+        ----------
+        partition : :class:`RefinablePartition`
+            The classes of equivalent states, the trash state being alone
+        """
+        n_symbols = len(transitions.symbols)
+        trash = len(transitions.states)
+        n_elements = trash + 1
+        partition = RefinablePartition(n_elements)
+        partition.mark_all(transitions.finals)
+        to_process = []
+        for new_set in partition.split():
+            to_process.extend((new_set, label)
+                              for label in range(n_symbols))
+        if n_symbols == 0:
+            return partition
+        sources = np.array(transitions.sources, dtype=np.int64)
+        labels = np.array(transitions.labels, dtype=np.int64)
+        targets = np.array(transitions.targets, dtype=np.int64)
+        # Complete the automaton with the trash state
+        present = np.zeros(n_elements * n_symbols, dtype=bool)
+        present[sources * n_symbols + labels] = True
+        missing = np.flatnonzero(~present)
+        sources = np.concatenate((sources, missing // n_symbols))
+        labels = np.concatenate((labels, missing % n_symbols))
+        targets = np.concatenate(
+            (targets, np.full(len(missing), trash, dtype=np.int64)))
+        keys = targets * n_symbols + labels
+        previous = sources[np.argsort(keys, kind="stable")].tolist()
+        offsets = np.zeros(n_elements * n_symbols + 1, dtype=np.int64)
+        np.cumsum(np.bincount(keys, minlength=n_elements * n_symbols),
+                  out=offsets[1:])
+        offsets = offsets.tolist()
+        while to_process:
+            set_id, label = to_process.pop()
+            to_mark = []
+            for element in partition.get_set(set_id):
+                key = element * n_symbols + label
+                to_mark.extend(previous[offsets[key]:offsets[key + 1]])
+            partition.mark_all(to_mark)
+            for new_set in partition.split():
+                to_process.extend((new_set, label)
+                                  for label in range(n_symbols))
+        return partition
+
+    @staticmethod
+    def _get_partition_valmari(transitions: "IntegerTransitions") \
+            -> RefinablePartition:
+        """ Groups the equivalent states with the algorithm of Valmari and \
+        Lehtinen
+
+        The transitions are partitioned too, in cords of transitions having \
+        the same label and leading to the same class of states. Each new \
+        class of states refines the cords through its incoming \
+        transitions, and each new cord refines the classes of states \
+        through the sources of its transitions. No trash state is needed, \
+        so the work only depends on the existing transitions.
+
+        Parameters
+        ----------
+        transitions : :class:`IntegerTransitions`
+            The transitions of an automaton without useless states
+
+        Returns
+        ----------
+        partition : :class:`RefinablePartition`
+            The classes of equivalent states
+        """
+        n_states = len(transitions.states)
+        sources = transitions.sources
+        labels = transitions.labels
+        blocks = RefinablePartition(n_states)
+        blocks.mark_all(transitions.finals)
+        blocks.split()
+        cords = RefinablePartition(len(sources))
+        by_label = [[] for _ in transitions.symbols]
+        incoming = [[] for _ in range(n_states)]
+        for transition, (label, target) in enumerate(
+                zip(labels, transitions.targets)):
+            by_label[label].append(transition)
+            incoming[target].append(transition)
+        for same_label in by_label[1:]:
+            cords.mark_all(same_label)
+            cords.split()
+        next_block = 1
+        next_cord = 0
+        while next_cord < len(cords):
+            blocks.mark_all([sources[transition]
+                             for transition in cords.get_set(next_cord)])
+            blocks.split()
+            next_cord += 1
+            while next_block < len(blocks):
+                to_mark = []
+                for state in blocks.get_set(next_block):
+                    to_mark.extend(incoming[state])
+                cords.mark_all(to_mark)
+                cords.split()
+                next_block += 1
+        return blocks
+
+    @staticmethod
+    def _get_quotient(transitions: "IntegerTransitions",
+                      partition: RefinablePartition) \
+            -> "DeterministicFiniteAutomaton":
+        """ Merges the equivalent states """
+        states = transitions.states
+        set_ids = partition.set_ids
+        new_states = {}
+        for set_id, elements in enumerate(partition.get_sets()):
+            elements = [states[element] for element in elements
+                        if element < len(states)]
+            if elements:
+                new_states[set_id] = to_single_state(elements)
+        dfa = DeterministicFiniteAutomaton()
+        dfa.add_start_state(new_states[set_ids[0]])
+        for final in transitions.finals:
+            dfa.add_final_state(new_states[set_ids[final]])
+        done = set()
+        for source, label, target in zip(transitions.sources,
+                                         transitions.labels,
+                                         transitions.targets):
+            if (set_ids[source], label) not in done:
+                done.add((set_ids[source], label))
+                dfa.add_transition(new_states[set_ids[source]],
+                                   transitions.symbols[label],
+                                   new_states[set_ids[target]])
+        return dfa
+
+    def _minimize_legacy(self) -> "DeterministicFiniteAutomaton":
         # Remove unreachable
         reachables = self._get_reachable_states()
         states = self._states.intersection(reachables)
@@ -395,74 +736,47 @@ class DeterministicFiniteAutomaton(NondeterministicFiniteAutomaton):
                         processing_list.insert(new_class, symbol)
         return partition
 
-    def is_equivalent_to(self, other):
-        """ Check whether two automata are equivalent
+    def get_equivalence_counterexample(self, other: "EpsilonNFA") \
+            -> Optional[List[Symbol]]:
+        """ Gives a word accepted by exactly one of two automata
+
+        When both automata are deterministic, the algorithm of Hopcroft and \
+        Karp is used: the pairs of states reached by the same words are \
+        merged with a union-find structure, without minimizing the \
+        automata.
 
         Parameters
         ----------
-        other :  :class:`~pyformlang.deterministic_finite_automaton\
-        .FiniteAutomaton`
-            A sequence of input symbols
+        other : :class:`~pyformlang.finite_automaton.EpsilonNFA`
+            An other finite state automaton
 
         Returns
-        ----------
-        are_equivalent : bool
-            Whether the two automata are equivalent or not
+        -------
+        counterexample : list of \
+        :class:`~pyformlang.finite_automaton.Symbol` or None
+            A shortest word in the symmetric difference of the languages, \
+            None if the automata are equivalent
 
         Examples
         --------
 
-        >>> dfa = DeterministicFiniteAutomaton()
-        >>> dfa.add_transitions([(0, "abc", 1), (0, "d", 1)])
-        >>> dfa.add_start_state(0)
-        >>> dfa.add_final_state(1)
-        >>> dfa_minimal = dfa.minimize()
-        >>> dfa.is_equivalent_to(dfa_minimal)
-        True
+        >>> dfa0 = DeterministicFiniteAutomaton()
+        >>> dfa0.add_transitions([(0, "a", 1), (1, "b", 0)])
+        >>> dfa0.add_start_state(0)
+        >>> dfa0.add_final_state(0)
+        >>> dfa1 = DeterministicFiniteAutomaton()
+        >>> dfa1.add_transitions([(0, "a", 1), (1, "b", 2), (2, "a", 1)])
+        >>> dfa1.add_start_state(0)
+        >>> dfa1.add_final_state(0)
+        >>> dfa0.get_equivalence_counterexample(dfa1)
+        [a, b]
 
         """
-        if not isinstance(other, DeterministicFiniteAutomaton):
-            other_dfa = other.to_deterministic()
-            return self.is_equivalent_to(other_dfa)
-        self_minimal = self.minimize()
-        other_minimal = other.minimize()
-        return self._is_equivalent_to_minimal(self_minimal, other_minimal)
+        if isinstance(other, DeterministicFiniteAutomaton):
+            return get_dfa_counterexample(self, other)
+        return super().get_equivalence_counterexample(other)
 
     @property
     def start_state(self) -> State:
         """ The start state """
         return list(self._start_state)[0]
-
-    @staticmethod
-    def _is_equivalent_to_minimal(self_minimal, other_minimal):
-        to_process = [(self_minimal.start_state,
-                       other_minimal.start_state)]
-        matches = {self_minimal.start_state: other_minimal.start_state}
-        while to_process:
-            current_self, current_other = to_process.pop()
-            if (self_minimal.is_final_state(current_self)
-                    and not other_minimal.is_final_state(current_other)) or \
-                    (not self_minimal.is_final_state(current_self)
-                     and other_minimal.is_final_state(current_other)):
-                return False
-            next_self = self_minimal(current_self)
-            next_other = other_minimal(current_other)
-            if len(next_self) != len(next_other):
-                return False
-            if len(next_self) == 0:
-                continue
-            for next_temp, other_temp in zip(sorted(list(next_self),
-                                                    key=lambda x: x[0].value),
-                                             sorted(list(next_other),
-                                                    key=lambda x: x[0].value)):
-                next_symbol_self, next_state_self = next_temp
-                next_symbol_other, next_state_other = other_temp
-                if next_symbol_other != next_symbol_self:
-                    return False
-                if next_state_self in matches:
-                    if matches[next_state_self] != next_state_other:
-                        return False
-                else:
-                    matches[next_state_self] = next_state_other
-                    to_process.append((next_state_self, next_state_other))
-        return True
@@ -2,7 +2,8 @@
 Nondeterministic Automaton with epsilon transitions
 """
 
-from typing import Set, Iterable, AbstractSet, Any
+from typing import Set, Iterable, AbstractSet, Any, Dict, FrozenSet, \
+    List, Optional
 
 # pylint: disable=cyclic-import
 from pyformlang import finite_automaton
@@ -13,6 +14,13 @@ from .symbol import Symbol
 from .nondeterministic_transition_function import \
     NondeterministicTransitionFunction
 from .regexable import Regexable
+from .bitset_nfa import BitsetNFA
+from .matcher import Matcher, BitsetMatcher
+from .equivalence import get_nfa_counterexample
+from .lazy_intersection import LazyIntersection
+from .state_elimination import get_regex
+from .inclusion import get_inclusion_counterexample, \
+    get_universality_counterexample
 from .finite_automaton import FiniteAutomaton
 from .finite_automaton import to_state, to_symbol
 
@@ -92,6 +100,8 @@ class EpsilonNFA(Regexable, FiniteAutomaton):
         for state in self._start_state:
             if state is not None and state not in self._states:
                 self._states.add(state)
+        self._bitset_nfa = None
+        self._closures = None
 
     def _get_next_states_iterable(self,
                                   current_states: Iterable[State],
@@ -147,15 +157,58 @@ class EpsilonNFA(Regexable, FiniteAutomaton):
         False
 
         """
-        word = [to_symbol(x) for x in word]
-        current_states = self.eclose_iterable(self._start_state)
-        for symbol in word:
-            if symbol == Epsilon():
-                continue
-            next_states = self._get_next_states_iterable(current_states,
-                                                         symbol)
-            current_states = self.eclose_iterable(next_states)
-        return any(self.is_final_state(x) for x in current_states)
+        return self._get_bitset_nfa().accepts(word)
+
+    def matcher(self) -> Matcher:
+        """ Gives a matcher reading words one symbol at a time, for \
+        streams of symbols
+
+        The current states of the matcher are a bitset. The matcher is \
+        dead when none of them can reach a final state. Epsilon symbols \
+        are ignored, as in :meth:`accepts`.
+
+        Returns
+        ----------
+        matcher : :class:`~pyformlang.finite_automaton.Matcher`
+            A matcher at the start of the automaton
+
+        Examples
+        --------
+
+        >>> enfa = EpsilonNFA()
+        >>> enfa.add_transitions([(0, "a", 0), (0, "b", 1)])
+        >>> enfa.add_start_state(0)
+        >>> enfa.add_final_state(1)
+        >>> matcher = enfa.matcher()
+        >>> matcher.feed_many(["a", "a", "b"])
+        True
+        >>> matcher.is_accepting()
+        True
+        >>> matcher.feed("b")
+        False
+        >>> matcher.is_dead()
+        True
+
+        """
+        return self._get_bitset_matcher(skip_epsilon=True)
+
+    def _get_bitset_matcher(self, skip_epsilon: bool) -> BitsetMatcher:
+        bitset_nfa = self._get_bitset_nfa()
+        useful_mask = 0
+        for state in self._get_states_leading_to_final():
+            useful_mask |= 1 << bitset_nfa.get_index(state)
+        return BitsetMatcher(bitset_nfa, useful_mask, skip_epsilon)
+
+    def _clear_cache(self):
+        self._bitset_nfa = None
+        self._closures = None
+
+    def _get_bitset_nfa(self) -> BitsetNFA:
+        """ Gives the bit-parallel version of the automaton, built once \
+        and kept until the automaton is modified """
+        if self._bitset_nfa is None:
+            self._bitset_nfa = BitsetNFA(self)
+        return self._bitset_nfa
 
     def eclose_iterable(self, states: Iterable[Any]) -> Set[State]:
         """ Compute the epsilon closure of a collection of states
@@ -181,10 +234,9 @@ class EpsilonNFA(Regexable, FiniteAutomaton):
         >>> enfa.eclose_iterable([0])
         {2}
         """
-        states = [to_state(x) for x in states]
         res = set()
         for state in states:
-            res = res.union(self.eclose(state))
+            res.update(self._get_closure(to_state(state)))
         return res
 
     def eclose(self, state: Any) -> Set[State]:
@@ -212,17 +264,80 @@ class EpsilonNFA(Regexable, FiniteAutomaton):
         {2}
 
         """
-        state = to_state(state)
-        to_process = [state]
-        processed = {state}
-        while to_process:
-            current = to_process.pop()
-            connected = self._transition_function(current, Epsilon())
-            for conn_state in connected:
-                if conn_state not in processed:
-                    processed.add(conn_state)
-                    to_process.append(conn_state)
-        return processed
+        return set(self._get_closure(to_state(state)))
+
+    def _get_closure(self, state: State) -> AbstractSet[State]:
+        """ Gives the epsilon closure of a state, from the cache """
+        if self._closures is None:
+            self._closures = self._compute_closures()
+        closure = self._closures.get(state)
+        if closure is None:
+            return frozenset({state})
+        return closure
+
+    # pylint: disable=too-many-locals
+    def _compute_closures(self) -> Dict[State, FrozenSet[State]]:
+        """ Computes the epsilon closures of all the states having \
+        epsilon transitions
+
+        The strongly connected components of the epsilon transitions are \
+        found with Tarjan's algorithm. They are produced successors first, \
+        so the closure of a component is the union of its states with the \
+        closures of the components it reaches directly. All the states of a \
+        component share the same closure.
+
+        Returns
+        ----------
+        closures : dict of :class:`~pyformlang.finite_automaton.State` \
+        to frozenset of :class:`~pyformlang.finite_automaton.State`
+            The closures, the ones of the missing states contain only \
+            the state itself
+        """
+        successors = {}
+        for s_from, symbol, s_to in self._transition_function:
+            if symbol == Epsilon():
+                successors.setdefault(s_from, []).append(s_to)
+        closures = {}
+        indexes = {}
+        lowlinks = {}
+        stack = []
+        on_stack = set()
+        for root in successors:
+            if root in indexes:
+                continue
+            indexes[root] = lowlinks[root] = len(indexes)
+            stack.append(root)
+            on_stack.add(root)
+            to_process = [(root, iter(successors[root]))]
+            while to_process:
+                current, children = to_process[-1]
+                for child in children:
+                    if child not in indexes:
+                        indexes[child] = lowlinks[child] = len(indexes)
+                        stack.append(child)
+                        on_stack.add(child)
+                        to_process.append(
+                            (child, iter(successors.get(child, []))))
+                        break
+                    if child in on_stack:
+                        lowlinks[current] = min(lowlinks[current],
+                                                indexes[child])
+                else:
+                    to_process.pop()
+                    if to_process:
+                        parent = to_process[-1][0]
+                        lowlinks[parent] = min(lowlinks[parent],
+                                               lowlinks[current])
+                    if lowlinks[current] == indexes[current]:
+                        component = []
+                        member = None
+                        while member != current:
+                            member = stack.pop()
+                            on_stack.remove(member)
+                            component.append(member)
+                        add_component_closure(component, successors,
+                                              closures)
+        return closures
 
     def is_deterministic(self) -> bool:
         """ Checks whether an automaton is deterministic
@@ -249,7 +364,7 @@ class EpsilonNFA(Regexable, FiniteAutomaton):
         """
         return len(self._start_state) <= 1 \
             and self._transition_function.is_deterministic()\
-            and all({x} == self.eclose(x) for x in self._states)
+            and all(len(self._get_closure(x)) == 1 for x in self._states)
 
     def remove_epsilon_transitions(self) -> "NondeterministicFiniteAutomaton":
         """ Removes the epsilon transitions from the automaton
@@ -271,24 +386,25 @@ nfa, with no epsilon transition
         for state in start_eclose:
             nfa.add_start_state(state)
         for state in self._states:
-            eclose = self.eclose(state)
-            for e_state in eclose:
+            for e_state in self._get_closure(state):
                 if e_state in self._final_states:
                     nfa.add_final_state(state)
-                for symb in self._input_symbols:
-                    for next_state in self._transition_function(e_state, symb):
+                for symb, next_state in \
+                        self._transition_function.get_transitions_from(
+                            e_state):
+                    if symb != Epsilon():
                         nfa.add_transition(state, symb, next_state)
         return nfa
 
-    def _to_deterministic_internal(self,
-                                   eclose: bool) \
+    def _to_deterministic_internal(self) \
             -> "DeterministicFiniteAutomaton":
         """ Transforms the epsilon-nfa into a dfa
 
-        Parameters
-        ----------
-        eclose : bool
-            Whether to use the epsilon closure or not
+        The subsets of states are represented as bitsets, built from the \
+        bit-parallel version of the automaton. Only the symbols leaving a \
+        subset are considered, and each subset is named once. The symbols \
+        with the same transitions form a minterm, whose next subset is \
+        computed once for all its symbols.
 
         Returns
         ----------
@@ -297,37 +413,28 @@ nfa, with no epsilon transition
             A dfa equivalent to the current nfa
         """
         dfa = finite_automaton.DeterministicFiniteAutomaton()
-        # Add Eclose
-        if eclose:
-            start_eclose = self.eclose_iterable(self._start_state)
-        else:
-            start_eclose = self._start_state
-        start_state = to_single_state(start_eclose)
-        dfa.add_start_state(start_state)
-        to_process = [start_eclose]
-        processed = {start_state}
+        bitset_nfa = self._get_bitset_nfa()
+        start_mask = bitset_nfa.start_mask
+        names = {start_mask: to_single_state(
+            bitset_nfa.get_states(start_mask))}
+        dfa.add_start_state(names[start_mask])
+        minterms = [[bitset_nfa.get_symbol(value) for value in minterm]
+                    for minterm in bitset_nfa.get_minterms()]
+        to_process = [start_mask]
         while to_process:
             current = to_process.pop()
-            s_from = to_single_state(current)
-            for symb in self._input_symbols:
-                all_trans = [self._transition_function(x, symb)
-                             for x in current]
-                state = set()
-                for trans in all_trans:
-                    state = state.union(trans)
-                if not state:
-                    continue
-                # Eclose added
-                if eclose:
-                    state = self.eclose_iterable(state)
-                state_merged = to_single_state(state)
-                dfa.add_transition(s_from, symb, state_merged)
-                if state_merged not in processed:
-                    processed.add(state_merged)
-                    to_process.append(state)
-            for state in current:
-                if state in self._final_states:
-                    dfa.add_final_state(s_from)
+            s_from = names[current]
+            for minterm, next_mask in \
+                    bitset_nfa.get_minterm_successors(current).items():
+                s_to = names.get(next_mask)
+                if s_to is None:
+                    s_to = to_single_state(bitset_nfa.get_states(next_mask))
+                    names[next_mask] = s_to
+                    to_process.append(next_mask)
+                for symbol in minterms[minterm]:
+                    dfa.add_transition(s_from, symbol, s_to)
+            if bitset_nfa.is_final_mask(current):
+                dfa.add_final_state(s_from)
         return dfa
 
     def to_deterministic(self) -> "DeterministicFiniteAutomaton":
@@ -355,7 +462,7 @@ nfa, with no epsilon transition
         True
 
         """
-        return self._to_deterministic_internal(True)
+        return self._to_deterministic_internal()
 
     def copy(self) -> "EpsilonNFA":
         """ Copies the current Epsilon NFA
@@ -383,14 +490,8 @@ nfa, with no epsilon transition
             enfa.add_start_state(start)
         for final in self._final_states:
             enfa.add_final_state(final)
-        for state in self._states:
-            for symbol in self._input_symbols:
-                states = self._transition_function(state, symbol)
-                for state_to in states:
-                    enfa.add_transition(state, symbol, state_to)
-            states = self._transition_function(state, Epsilon())
-            for state_to in states:
-                enfa.add_transition(state, Epsilon(), state_to)
+        for state, symbol, state_to in self._transition_function.get_edges():
+            enfa.add_transition(state, symbol, state_to)
         return enfa
 
     def __copy__(self):
@@ -399,6 +500,11 @@ nfa, with no epsilon transition
     def to_regex(self) -> "Regex":
         """ Transforms the EpsilonNFA to a regular expression
 
+        The states are eliminated one by one, those creating the fewest \
+        new transitions first, and the regular expression is built as a \
+        tree. The symbols of the automaton are the symbols of the regular \
+        expression, whatever their value.
+
         Returns
         ----------
         regex : :class:`~pyformlang.regular_expression.Regex`
@@ -417,23 +523,7 @@ nfa, with no epsilon transition
         True
 
         """
-        from pyformlang.regular_expression import Regex
-        enfas = [self.copy() for _ in self._final_states]
-        final_states = list(self._final_states)
-        for i in range(len(self._final_states)):
-            for j in range(len(self._final_states)):
-                if i != j:
-                    enfas[j].remove_final_state(final_states[i])
-        regex_l = []
-        for enfa in enfas:
-            # pylint: disable=protected-access
-            enfa._remove_all_basic_states()
-            # pylint: disable=protected-access
-            regex_sub = enfa._get_regex_simple()
-            if regex_sub:
-                regex_l.append(regex_sub)
-        res = "+".join(regex_l)
-        return Regex(res)
+        return get_regex(self)
 
     def _get_regex_simple(self) -> str:
         """ Get the regex of an automaton when it only composed of a start and
@@ -541,8 +631,7 @@ nfa, with no epsilon transition
         for state in self._states:
             for symbol in self._input_symbols:
                 state_to = []
-                eclose = self.eclose(state)
-                for state0 in eclose:
+                for state0 in self._get_closure(state):
                     state_to += self._transition_function(state0, symbol)
                 if not state_to:
                     enfa.add_transition(state, symbol, trash)
@@ -598,7 +687,6 @@ nfa, with no epsilon transition
 
         """
         enfa = EpsilonNFA()
-        symbols = list(self.symbols.intersection(other.symbols))
         to_process = []
         processed = set()
         for st0 in self.eclose_iterable(self.start_states):
@@ -612,7 +700,11 @@ nfa, with no epsilon transition
         while to_process:
             st0, st1 = to_process.pop()
             current_state = combine_state_pair(st0, st1)
-            for symb in symbols:
+            # pylint: disable=protected-access
+            symbols1 = other._transition_function.get_symbols_from(st1)
+            for symb in self._transition_function.get_symbols_from(st0):
+                if symb == Epsilon() or symb not in symbols1:
+                    continue
                 for new_s0 in self.eclose_iterable(self(st0, symb)):
                     for new_s1 in other.eclose_iterable(other(st1, symb)):
                         state = combine_state_pair(new_s0, new_s1)
@@ -622,6 +714,39 @@ nfa, with no epsilon transition
                             to_process.append((new_s0, new_s1))
         return enfa
 
+    def get_lazy_intersection(self, *others: "EpsilonNFA") \
+            -> LazyIntersection:
+        """ Gives the intersection with other Epsilon NFAs, without \
+        building the product automaton
+
+        Parameters
+        ----------
+        others : :class:`~pyformlang.finite_automaton.EpsilonNFA`
+            The other Epsilon NFAs, any number of them
+
+        Returns
+        ---------
+        intersection : :class:`~pyformlang.finite_automaton.LazyIntersection`
+            The intersection, whose product is explored when queried
+
+        Examples
+        --------
+
+        >>> enfa = EpsilonNFA()
+        >>> enfa.add_transitions([(0, "abc", 1), (0, "d", 1), \
+        (0, "epsilon", 2)])
+        >>> enfa.add_start_state(0)
+        >>> enfa.add_final_state(1)
+        >>> enfa2 = EpsilonNFA()
+        >>> enfa2.add_transition(0, "d", 1)
+        >>> enfa2.add_final_state(1)
+        >>> enfa2.add_start_state(0)
+        >>> enfa.get_lazy_intersection(enfa2).is_empty()
+        False
+
+        """
+        return LazyIntersection([self, *others])
+
     def __and__(self, other):
         """ Computes the intersection of two Epsilon NFAs
 
@@ -722,12 +847,8 @@ nfa, with no epsilon transition
 
         """
         enfa = EpsilonNFA()
-        for state0 in self._states:
-            for symbol in self._input_symbols:
-                for state1 in self._transition_function(state0, symbol):
-                    enfa.add_transition(state1, symbol, state0)
-            for state1 in self._transition_function(state0, Epsilon()):
-                enfa.add_transition(state1, Epsilon(), state0)
+        for state0, symbol, state1 in self._transition_function.get_edges():
+            enfa.add_transition(state1, symbol, state0)
         for start in self._start_state:
             enfa.add_final_state(start)
         for final in self._final_states:
@@ -784,6 +905,199 @@ nfa, with no epsilon transition
                     processed.add(state)
         return True
 
+    def is_equivalent_to(self, other: "EpsilonNFA") -> bool:
+        """ Checks if the current automaton is equivalent to a given one
+
+        The automata are determinized on the fly and the search stops as \
+        soon as they are proven equivalent or different, see \
+        :meth:`get_equivalence_counterexample`.
+
+        Parameters
+        ----------
+        other : :class:`~pyformlang.finite_automaton.EpsilonNFA`
+            An other finite state automaton
+
+        Returns
+        -------
+        is_equivalent : bool
+            Whether the two automata are equivalent or not
+
+        Examples
+        --------
+
+        >>> enfa0 = EpsilonNFA()
+        >>> enfa0.add_transitions([(0, "a", 1), (0, "epsilon", 2), \
+        (2, "a", 1)])
+        >>> enfa0.add_start_state(0)
+        >>> enfa0.add_final_state(1)
+        >>> enfa1 = EpsilonNFA()
+        >>> enfa1.add_transition(0, "a", 1)
+        >>> enfa1.add_start_state(0)
+        >>> enfa1.add_final_state(1)
+        >>> enfa0.is_equivalent_to(enfa1)
+        True
+
+        """
+        return self.get_equivalence_counterexample(other) is None
+
+    def get_equivalence_counterexample(self, other: "EpsilonNFA") \
+            -> Optional[List[Symbol]]:
+        """ Gives a word accepted by exactly one of two automata
+
+        The automata are compared with bisimulation up to congruence \
+        (HKC), on bitsets: the pairs of sets of states which follow from \
+        the ones already visited are not explored, which avoids building \
+        most of the deterministic automata.
+
+        Parameters
+        ----------
+        other : :class:`~pyformlang.finite_automaton.EpsilonNFA`
+            An other finite state automaton
+
+        Returns
+        -------
+        counterexample : list of \
+        :class:`~pyformlang.finite_automaton.Symbol` or None
+            A word in the symmetric difference of the languages, None if \
+            the automata are equivalent
+
+        Examples
+        --------
+
+        >>> enfa0 = EpsilonNFA()
+        >>> enfa0.add_transitions([(0, "a", 1), (1, "b", 1)])
+        >>> enfa0.add_start_state(0)
+        >>> enfa0.add_final_state(1)
+        >>> enfa1 = EpsilonNFA()
+        >>> enfa1.add_transition(0, "a", 1)
+        >>> enfa1.add_start_state(0)
+        >>> enfa1.add_final_state(1)
+        >>> enfa0.get_equivalence_counterexample(enfa1)
+        [a, b]
+
+        """
+        return get_nfa_counterexample(self, other)
+
+    def is_subset_of(self, other: "EpsilonNFA") -> bool:
+        """ Checks if the language of the current automaton is included in \
+        the one of a given automaton
+
+        Parameters
+        ----------
+        other : :class:`~pyformlang.finite_automaton.EpsilonNFA`
+            An other finite state automaton
+
+        Returns
+        -------
+        is_subset : bool
+            Whether the language is included or not
+
+        Examples
+        --------
+
+        >>> enfa0 = EpsilonNFA()
+        >>> enfa0.add_transitions([(0, "a", 1), (1, "b", 2)])
+        >>> enfa0.add_start_state(0)
+        >>> enfa0.add_final_state(2)
+        >>> enfa1 = EpsilonNFA()
+        >>> enfa1.add_transitions([(0, "a", 0), (0, "b", 0)])
+        >>> enfa1.add_start_state(0)
+        >>> enfa1.add_final_state(0)
+        >>> enfa0.is_subset_of(enfa1)
+        True
+
+        """
+        return self.get_inclusion_counterexample(other) is None
+
+    def get_inclusion_counterexample(self, other: "EpsilonNFA") \
+            -> Optional[List[Symbol]]:
+        """ Gives a word accepted by the current automaton and rejected by \
+        a given one
+
+        The other automaton is not complemented: the search runs on pairs \
+        of a state and a set of states, pruned with antichains.
+
+        Parameters
+        ----------
+        other : :class:`~pyformlang.finite_automaton.EpsilonNFA`
+            An other finite state automaton
+
+        Returns
+        -------
+        counterexample : list of \
+        :class:`~pyformlang.finite_automaton.Symbol` or None
+            A word showing that the language is not included, None if it is
+
+        Examples
+        --------
+
+        >>> enfa0 = EpsilonNFA()
+        >>> enfa0.add_transitions([(0, "a", 1), (1, "b", 2)])
+        >>> enfa0.add_start_state(0)
+        >>> enfa0.add_final_state(2)
+        >>> enfa1 = EpsilonNFA()
+        >>> enfa1.add_transition(0, "a", 0)
+        >>> enfa1.add_start_state(0)
+        >>> enfa1.add_final_state(0)
+        >>> enfa0.get_inclusion_counterexample(enfa1)
+        [a, b]
+
+        """
+        return get_inclusion_counterexample(self, other)
+
+    def is_universal(self) -> bool:
+        """ Checks if the automaton accepts all the words built from its \
+        symbols
+
+        Returns
+        -------
+        is_universal : bool
+            Whether all the words are accepted or not
+
+        Examples
+        --------
+
+        >>> enfa = EpsilonNFA()
+        >>> enfa.add_transitions([(0, "a", 0), (0, "b", 1), (1, "a", 0), \
+        (1, "b", 1)])
+        >>> enfa.add_start_state(0)
+        >>> enfa.add_final_state(0)
+        >>> enfa.is_universal()
+        False
+        >>> enfa.add_final_state(1)
+        >>> enfa.is_universal()
+        True
+
+        """
+        return self.get_universality_counterexample() is None
+
+    def get_universality_counterexample(self) -> Optional[List[Symbol]]:
+        """ Gives a shortest word built from the symbols of the automaton \
+        and rejected by it
+
+        The sets of states are explored without complementing the \
+        automaton, and the ones including an explored set are pruned.
+
+        Returns
+        -------
+        counterexample : list of \
+        :class:`~pyformlang.finite_automaton.Symbol` or None
+            A rejected word, None if there is none
+
+        Examples
+        --------
+
+        >>> enfa = EpsilonNFA()
+        >>> enfa.add_transitions([(0, "a", 0), (0, "b", 1), (1, "a", 0)])
+        >>> enfa.add_start_state(0)
+        >>> enfa.add_final_state(0)
+        >>> enfa.add_final_state(1)
+        >>> enfa.get_universality_counterexample()
+        [b, b]
+
+        """
+        return get_universality_counterexample(self, self._input_symbols)
+
     def _remove_all_basic_states(self):
         """ Remove all states which are not the start state or a final state
 
@@ -1017,6 +1331,21 @@ def get_regex_sub(start_to_start: str,
     return "(" + part0 + "." + part1 + ")"
 
 
+def add_component_closure(component: List[State],
+                          successors: Dict[State, List[State]],
+                          closures: Dict[State, FrozenSet[State]]):
+    """ Computes the shared epsilon closure of a strongly connected \
+    component, whose successor components are already closed """
+    closure = set(component)
+    for member in component:
+        for child in successors.get(member, []):
+            if child not in closure:
+                closure.update(closures[child])
+    closure = frozenset(closure)
+    for member in component:
+        closures[member] = closure
+
+
 def to_single_state(l_states: Iterable[State]) -> State:
     """ Merge a list of states
 
@@ -0,0 +1,195 @@
+"""
+Equivalence checks between automata which do not need to minimize or to \
+fully determinize them
+"""
+
+from collections import deque
+from typing import List, Optional, Dict, Any, Tuple
+
+from .symbol import Symbol
+
+
+def get_word(parents: List[Tuple[int, Any]], node: int) -> List[Any]:
+    """ Rebuilds the word leading to a node of a search
+
+    Parameters
+    ----------
+    parents : list of (int, any)
+        For each node, its parent node and the symbol read from it. The \
+        root has -1 as parent
+    node : int
+        The node reached
+
+    Returns
+    ----------
+    word : list of any
+        The symbols read from the root to the node
+    """
+    word = []
+    while parents[node][0] != -1:
+        node, symbol = parents[node]
+        word.append(symbol)
+    word.reverse()
+    return word
+
+
+class UnionFind:
+    """ Union-find with path halving and union by size
+
+    For internal usage.
+    """
+
+    def __init__(self):
+        self._parents = {}
+        self._sizes = {}
+
+    def find(self, element: Any) -> Any:
+        """ Gives the representative of the class of an element """
+        parents = self._parents
+        if element not in parents:
+            parents[element] = element
+            self._sizes[element] = 1
+            return element
+        while parents[element] != element:
+            parents[element] = parents[parents[element]]
+            element = parents[element]
+        return element
+
+    def union(self, root0: Any, root1: Any):
+        """ Merges two classes, given by their representatives """
+        if self._sizes[root0] < self._sizes[root1]:
+            root0, root1 = root1, root0
+        self._parents[root1] = root0
+        self._sizes[root0] += self._sizes[root1]
+
+
+def get_dfa_counterexample(dfa0, dfa1) -> Optional[List[Symbol]]:
+    """ Looks for a word accepted by exactly one of two DFAs, with the \
+    algorithm of Hopcroft and Karp
+
+    The pairs of states reached by the same words are merged in a \
+    union-find structure, so each state is expanded at most once and the \
+    automata are neither completed nor minimized. A missing transition \
+    leads to an implicit dead state.
+
+    Parameters
+    ----------
+    dfa0 : :class:`~pyformlang.finite_automaton.DeterministicFiniteAutomaton`
+        The first automaton
+    dfa1 : :class:`~pyformlang.finite_automaton.DeterministicFiniteAutomaton`
+        The second automaton
+
+    Returns
+    ----------
+    counterexample : list of :class:`~pyformlang.finite_automaton.Symbol` \
+    or None
+        A shortest word in the symmetric difference of the languages, None \
+        if the automata are equivalent
+    """
+    # pylint: disable=too-many-locals
+    automata = (dfa0, dfa1)
+    transitions = ({}, {})
+
+    def get_transitions(side: int, state: Any) -> Dict[Symbol, Any]:
+        if state is None:
+            return {}
+        if state not in transitions[side]:
+            # pylint: disable=protected-access
+            transitions[side][state] = dict(
+                automata[side]._transition_function.get_transitions_from(
+                    state))
+        return transitions[side][state]
+
+    def is_final(side: int, state: Any) -> bool:
+        return state is not None and automata[side].is_final_state(state)
+
+    starts = tuple(automaton.start_state if automaton.start_states else None
+                   for automaton in automata)
+    classes = UnionFind()
+    parents = [(-1, None)]
+    to_process = deque([(starts[0], starts[1], 0)])
+    while to_process:
+        state0, state1, node = to_process.popleft()
+        root0 = classes.find((0, state0))
+        root1 = classes.find((1, state1))
+        if root0 == root1:
+            continue
+        if is_final(0, state0) != is_final(1, state1):
+            return get_word(parents, node)
+        classes.union(root0, root1)
+        transitions0 = get_transitions(0, state0)
+        transitions1 = get_transitions(1, state1)
+        for symbol in set(transitions0).union(transitions1):
+            parents.append((node, symbol))
+            to_process.append((transitions0.get(symbol),
+                               transitions1.get(symbol),
+                               len(parents) - 1))
+    return None
+
+
+def _saturate(mask: int, relation: List[Tuple[int, int]]) -> int:
+    """ Closes a set of states under the rewriting rules of a relation """
+    changed = True
+    while changed:
+        changed = False
+        for left, right in relation:
+            if left & mask == left and right & mask != right:
+                mask |= right
+                changed = True
+            elif right & mask == right and left & mask != left:
+                mask |= left
+                changed = True
+    return mask
+
+
+def get_nfa_counterexample(enfa0, enfa1) -> Optional[List[Symbol]]:
+    """ Looks for a word accepted by exactly one of two epsilon NFAs, with \
+    bisimulation up to congruence (HKC)
+
+    The automata are determinized on the fly, on bitsets. A pair of sets \
+    of states is skipped when it already follows from the pairs visited \
+    before by congruence closure, which usually prunes most of the \
+    subset construction.
+
+    Parameters
+    ----------
+    enfa0 : :class:`~pyformlang.finite_automaton.EpsilonNFA`
+        The first automaton
+    enfa1 : :class:`~pyformlang.finite_automaton.EpsilonNFA`
+        The second automaton
+
+    Returns
+    ----------
+    counterexample : list of :class:`~pyformlang.finite_automaton.Symbol` \
+    or None
+        A word in the symmetric difference of the languages, None if the \
+        automata are equivalent
+    """
+    # pylint: disable=protected-access, too-many-locals
+    bitset0 = enfa0._get_bitset_nfa()
+    bitset1 = enfa1._get_bitset_nfa()
+    # The sets of states of the second automaton are shifted after the ones
+    # of the first automaton in the relation
+    shift = len(bitset0)
+    relation = []
+    parents = [(-1, None)]
+    to_process = deque([(bitset0.start_mask, bitset1.start_mask, 0)])
+    while to_process:
+        mask0, mask1, node = to_process.popleft()
+        combined0 = mask0
+        combined1 = mask1 << shift
+        if _saturate(combined0, relation) == _saturate(combined1, relation):
+            continue
+        if bitset0.is_final_mask(mask0) != bitset1.is_final_mask(mask1):
+            return [bitset0.get_symbol(value) if bitset0.has_symbol(value)
+                    else bitset1.get_symbol(value)
+                    for value in get_word(parents, node)]
+        relation.append((combined0, combined1))
+        successors0 = bitset0.get_successors(mask0)
+        successors1 = bitset1.get_successors(mask1)
+        for value in set(successors0).union(successors1):
+            parents.append((node, value))
+            to_process.append((successors0.get(value, 0),
+                               successors1.get(value, 0),
+                               len(parents) - 1))
+    return None
@@ -44,6 +44,10 @@ class FiniteAutomaton:
         self._start_state = set()
         self._final_states = set()
 
+    def _clear_cache(self):
+        """ Forgets the structures computed from the automaton, called \
+        whenever it is modified """
+
     def add_transition(self, s_from: Any, symb_by: Any,
                        s_to: Any) -> int:
         """ Adds a transition to the nfa
@@ -83,6 +87,7 @@ class FiniteAutomaton:
         self._states.add(s_to)
         if symb_by != Epsilon():
             self._input_symbols.add(symb_by)
+        self._clear_cache()
         return temp
 
     def add_transitions(self, transitions_list):
@@ -114,10 +119,112 @@ class FiniteAutomaton:
 
 
         """
-        temp = 0
-        for s_from, symb_by, s_to in transitions_list:
-            temp = self.add_transition(s_from, symb_by, s_to)
-        return temp
+        transitions_list = list(transitions_list)
+        return self._add_edge_lists(
+            [transition[0] for transition in transitions_list],
+            [transition[1] for transition in transitions_list],
+            [transition[2] for transition in transitions_list])
+
+    def _to_transition_symbol(self, given: Any) -> Symbol:
+        """ Transforms the input into a symbol which can label a \
+        transition of the automaton """
+        return to_symbol(given)
+
+    def _add_edge_lists(self, sources: List[Any], symbols: List[Any],
+                        targets: List[Any]) -> int:
+        """ Adds transitions given as parallel lists of values
+
+        Each distinct value is transformed into a state or a symbol only \
+        once, the transitions are then given to the transition function in \
+        a single pass and the sets of states and symbols are updated once.
+        """
+        states = {value: to_state(value)
+                  for value in set(sources).union(targets)}
+        labels = {value: self._to_transition_symbol(value)
+                  for value in set(symbols)}
+        added = 0
+        try:
+            self._transition_function.add_transitions(
+                zip(map(states.__getitem__, sources),
+                    map(labels.__getitem__, symbols),
+                    map(states.__getitem__, targets)))
+            added = len(sources)
+        finally:
+            # When a transition is refused, only the ones before it were
+            # added, and only their states and symbols are registered
+            # pylint: disable=not-callable
+            while added < len(sources) and \
+                    states[targets[added]] in self._transition_function(
+                        states[sources[added]], labels[symbols[added]]):
+                added += 1
+            if added < len(sources):
+                states = {value: states[value]
+                          for value in sources[:added] + targets[:added]}
+                labels = {value: labels[value] for value in symbols[:added]}
+            self._states.update(states.values())
+            epsilon = Epsilon()
+            self._input_symbols.update(symbol for symbol in labels.values()
+                                       if symbol != epsilon)
+            self._clear_cache()
+        return 1 if sources else 0
+
+    @classmethod
+    def from_edge_arrays(cls, sources: Iterable[Any], symbols: Iterable[Any],
+                         targets: Iterable[Any],
+                         start_states: Iterable[Any] = None,
+                         final_states: Iterable[Any] = None):
+        """ Builds an automaton from parallel arrays of edges
+
+        This is much faster than adding the transitions one by one for \
+        large automata: each distinct value is transformed into a state or \
+        a symbol only once and the transition tables are filled directly.
+
+        Parameters
+        ----------
+        sources : iterable of any
+            The source states of the transitions, or their values. Numpy \
+            arrays are accepted.
+        symbols : iterable of any
+            The symbols of the transitions, or their values
+        targets : iterable of any
+            The destination states of the transitions, or their values
+        start_states : iterable of any, optional
+            The start states
+        final_states : iterable of any, optional
+            The final states
+
+        Returns
+        -------
+        automaton :
+            An automaton of the class on which the method is called
+
+        Raises
+        --------
+        ValueError
+            If the arrays do not have the same length
+
+        Examples
+        --------
+
+        >>> enfa = EpsilonNFA.from_edge_arrays([0, 0, 1], ["a", "b", "a"], \
+        [1, 1, 2], start_states=[0], final_states=[2])
+        >>> enfa.accepts(["b", "a"])
+        True
+
+        """
+        sources = _to_list(sources)
+        symbols = _to_list(symbols)
+        targets = _to_list(targets)
+        if not len(sources) == len(symbols) == len(targets):
+            raise ValueError("The arrays of edges must have the same length")
+        automaton = cls()
+        # pylint: disable=protected-access
+        automaton._add_edge_lists(sources, symbols, targets)
+        for state in start_states or []:
+            automaton.add_start_state(state)
+        for state in final_states or []:
+            automaton.add_final_state(state)
+        return automaton
 
     def remove_transition(self, s_from: State, symb_by: Symbol,
                           s_to: State) -> int:
@@ -149,6 +256,7 @@ class FiniteAutomaton:
         s_from = to_state(s_from)
         symb_by = to_symbol(symb_by)
         s_to = to_state(s_to)
+        self._clear_cache()
         return self._transition_function.remove_transition(s_from,
                                                            symb_by,
                                                            s_to)
@@ -219,6 +327,7 @@ class FiniteAutomaton:
         state = to_state(state)
         self._start_state.add(state)
         self._states.add(state)
+        self._clear_cache()
         return 1
 
     def remove_start_state(self, state: State) -> int:
@@ -247,6 +356,7 @@ class FiniteAutomaton:
         state = to_state(state)
         if state in self._start_state:
             self._start_state.remove(state)
+            self._clear_cache()
             return 1
         return 0
 
@@ -276,6 +386,7 @@ class FiniteAutomaton:
         state = to_state(state)
         self._final_states.add(state)
         self._states.add(state)
+        self._clear_cache()
         return 1
 
     def remove_final_state(self, state: State) -> int:
@@ -304,6 +415,7 @@ class FiniteAutomaton:
         state = to_state(state)
         if self.is_final_state(state):
             self._final_states.remove(state)
+            self._clear_cache()
             return 1
         return 0
 
@@ -630,29 +742,19 @@ class FiniteAutomaton:
         """
         Gets a set of states from which one
         of the final states can be reached.
+
+        The transitions are followed backward from the final states.
         """
-        leading_to_final = self.final_states.copy()
-        visited = set()
-        states_to_process = deque((None, start_state)
-                                  for start_state in self.start_states)
-        delayed_states = deque()
+        leading_to_final = set(self.final_states)
+        states_to_process = list(leading_to_final)
         while states_to_process:
-            previous_state, current_state = states_to_process.pop()
-            if previous_state and current_state in leading_to_final:
-                leading_to_final.add(previous_state)
-                continue
-            if current_state in visited:
-                delayed_states.append((previous_state, current_state))
-                continue
-            visited.add(current_state)
-            next_states = self._get_next_states_from(current_state)
-            if next_states:
-                states_to_process.append((previous_state, current_state))
-                for next_state in next_states:
-                    states_to_process.append((current_state, next_state))
-        for previous_state, current_state in delayed_states:
-            if previous_state and current_state in leading_to_final:
-                leading_to_final.add(previous_state)
+            current_state = states_to_process.pop()
+            for _, previous_state in \
+                    self._transition_function.get_transitions_to(
+                        current_state):
+                if previous_state not in leading_to_final:
+                    leading_to_final.add(previous_state)
+                    states_to_process.append(previous_state)
         return leading_to_final
 
     def _get_reachable_states(self) -> Set[State]:
@@ -729,6 +831,14 @@ class FiniteAutomaton:
         return len(set_to_add_to) != initial_length
 
 
+def _to_list(values: Iterable[Any]) -> List[Any]:
+    """ Gives the values as a list of python objects, numpy arrays being \
+    converted in a single call """
+    if hasattr(values, "tolist"):
+        return values.tolist()
+    return list(values)
+
+
 def to_state(given: Any) -> Union[State, None]:
     """ Transforms the input into a state
 
@@ -0,0 +1,114 @@
+"""
+Language inclusion and universality checks based on antichains
+"""
+
+from collections import deque
+from typing import List, Optional, Dict, Iterable, Any
+
+from .bitset_nfa import iterate_bits
+from .equivalence import get_word
+from .symbol import Symbol
+
+
+def _is_subsumed(antichain: List[int], mask: int) -> bool:
+    """ Whether a set contains one of the sets of an antichain """
+    return any(smaller & mask == smaller for smaller in antichain)
+
+
+def _add_to_antichain(antichain: List[int], mask: int):
+    """ Adds a set to an antichain, removing the sets it is included in """
+    antichain[:] = [larger for larger in antichain
+                    if mask & larger != mask]
+    antichain.append(mask)
+
+
+def get_inclusion_counterexample(enfa0, enfa1) -> Optional[List[Symbol]]:
+    """ Looks for a word accepted by a first automaton and rejected by a \
+    second one
+
+    The search explores pairs made of a state of the first automaton and \
+    a set of states of the second one, reached by the same word. A pair is \
+    not explored when a pair with the same state and a subset of its set \
+    was already explored, as it could not lead to a shorter \
+    counterexample. The second automaton is never complemented nor fully \
+    determinized.
+
+    Parameters
+    ----------
+    enfa0 : :class:`~pyformlang.finite_automaton.EpsilonNFA`
+        The automaton whose language should be included
+    enfa1 : :class:`~pyformlang.finite_automaton.EpsilonNFA`
+        The automaton whose language should include
+
+    Returns
+    ----------
+    counterexample : list of :class:`~pyformlang.finite_automaton.Symbol` \
+    or None
+        A word accepted by the first automaton but not by the second one, \
+        None if there is none
+    """
+    # pylint: disable=protected-access
+    bitset0 = enfa0._get_bitset_nfa()
+    bitset1 = enfa1._get_bitset_nfa()
+    antichains: Dict[int, List[int]] = {}
+    parents = [(-1, None)]
+    to_process = deque()
+    for state in iterate_bits(bitset0.start_mask):
+        to_process.append((state, bitset1.start_mask, 0))
+    while to_process:
+        state, mask, node = to_process.popleft()
+        antichain = antichains.setdefault(state, [])
+        if _is_subsumed(antichain, mask):
+            continue
+        if bitset0.is_final_mask(1 << state) \
+                and not bitset1.is_final_mask(mask):
+            return [bitset0.get_symbol(value)
+                    for value in get_word(parents, node)]
+        _add_to_antichain(antichain, mask)
+        for value, next_states in bitset0.get_successors(1 << state).items():
+            next_mask = bitset1.step(mask, value)
+            parents.append((node, value))
+            for next_state in iterate_bits(next_states):
+                to_process.append((next_state, next_mask, len(parents) - 1))
+    return None
+
+
+def get_universality_counterexample(enfa, symbols: Iterable[Any]) \
+        -> Optional[List[Symbol]]:
+    """ Looks for a word rejected by an automaton
+
+    The sets of states reached by words are explored breadth-first. A set \
+    is not explored when a subset of it was already explored, as it \
+    could not lead to a shorter counterexample.
+
+    Parameters
+    ----------
+    enfa : :class:`~pyformlang.finite_automaton.EpsilonNFA`
+        The automaton
+    symbols : iterable of :class:`~pyformlang.finite_automaton.Symbol`
+        The alphabet the words are built from
+
+    Returns
+    ----------
+    counterexample : list of :class:`~pyformlang.finite_automaton.Symbol` \
+    or None
+        A shortest word rejected by the automaton, None if there is none
+    """
+    # pylint: disable=protected-access
+    bitset_nfa = enfa._get_bitset_nfa()
+    symbols = list(symbols)
+    antichain = []
+    parents = [(-1, None)]
+    to_process = deque([(bitset_nfa.start_mask, 0)])
+    while to_process:
+        mask, node = to_process.popleft()
+        if _is_subsumed(antichain, mask):
+            continue
+        if not bitset_nfa.is_final_mask(mask):
+            return get_word(parents, node)
+        _add_to_antichain(antichain, mask)
+        for symbol in symbols:
+            parents.append((node, symbol))
+            to_process.append((bitset_nfa.step(mask, symbol.value),
+                               len(parents) - 1))
+    return None
@@ -0,0 +1,150 @@
+"""
+A deterministic automaton built on demand from a nondeterministic one
+"""
+
+from typing import Iterable, Any, Dict
+
+from .epsilon import Epsilon
+from .finite_automaton import to_symbol
+
+
+class LazyDFA:
+    """ A deterministic version of an epsilon NFA, whose states are only \
+    discovered while reading words.
+
+    The states of the deterministic automaton are sets of states of the \
+    epsilon NFA, represented as bitsets. The transitions computed while \
+    matching are cached, so that a transition is only computed once. When \
+    the cache exceeds its maximal size, it is flushed and the \
+    determinization starts again from the states currently used. This \
+    allows matching with automata whose full deterministic version would \
+    be too large.
+
+    The automaton does not follow later modifications of the epsilon NFA \
+    it was built from.
+
+    Parameters
+    ----------
+    enfa : :class:`~pyformlang.finite_automaton.EpsilonNFA`
+        The automaton to determinize
+    max_cache_size : int, optional
+        The maximal number of states kept in the cache, unbounded by default
+
+    Examples
+    --------
+
+    >>> enfa = EpsilonNFA()
+    >>> enfa.add_transitions([(0, "a", 0), (0, "b", 0), (0, "a", 1), \
+    (1, "b", 2)])
+    >>> enfa.add_start_state(0)
+    >>> enfa.add_final_state(2)
+    >>> lazy_dfa = LazyDFA(enfa, max_cache_size=100)
+    >>> lazy_dfa.accepts(["b", "a", "b"])
+    True
+    >>> lazy_dfa.cache_size
+    3
+
+    """
+
+    def __init__(self, enfa, max_cache_size: int = None):
+        # pylint: disable=protected-access
+        self._bitset_nfa = enfa._get_bitset_nfa()
+        self._max_cache_size = max_cache_size
+        self._cache: Dict[int, Dict[Any, int]] = {}
+
+    @property
+    def start_state(self) -> int:
+        """ The start state, as a bitset of states of the epsilon NFA """
+        return self._bitset_nfa.start_mask
+
+    @property
+    def cache_size(self) -> int:
+        """ The number of states currently in the cache """
+        return len(self._cache)
+
+    def clear_cache(self):
+        """ Forgets all the discovered states and transitions """
+        self._cache = {}
+
+    def get_states(self, state: int) -> set:
+        """ Gives the states of the epsilon NFA forming a state
+
+        Parameters
+        ----------
+        state : int
+            A state of the lazy automaton
+
+        Returns
+        ----------
+        states : set of :class:`~pyformlang.finite_automaton.State`
+            The corresponding states of the epsilon NFA
+        """
+        return self._bitset_nfa.get_states(state)
+
+    def is_final(self, state: int) -> bool:
+        """ Whether a state is final """
+        return self._bitset_nfa.is_final_mask(state)
+
+    def get_next_state(self, state: int, symbol: Any) -> int:
+        """ Gives the next state, computing it if needed
+
+        Parameters
+        ----------
+        state : int
+            The source state
+        symbol : any
+            The symbol read, or its value. It must not be epsilon
+
+        Returns
+        ----------
+        state : int
+            The destination state, 0 if there is none
+        """
+        transitions = self._get_transitions(state)
+        next_state = transitions.get(symbol)
+        if next_state is None:
+            next_state = self._bitset_nfa.step(state, symbol)
+            transitions[symbol] = next_state
+        return next_state
+
+    def _get_transitions(self, state: int) -> Dict[Any, int]:
+        transitions = self._cache.get(state)
+        if transitions is None:
+            if self._max_cache_size is not None \
+                    and len(self._cache) >= self._max_cache_size:
+                self._cache = {}
+            transitions = {}
+            self._cache[state] = transitions
+        return transitions
+
+    def accepts(self, word: Iterable[Any]) -> bool:
+        """ Checks whether the automaton accepts a given word
+
+        Parameters
+        ----------
+        word : iterable of any
+            A sequence of symbols, or of their values. Epsilon symbols are \
+            ignored
+
+        Returns
+        ----------
+        is_accepted : bool
+            Whether the word is accepted or not
+        """
+        bitset_nfa = self._bitset_nfa
+        current = bitset_nfa.start_mask
+        transitions = self._get_transitions(current)
+        for symbol in word:
+            next_state = transitions.get(symbol)
+            if next_state is None:
+                if not bitset_nfa.has_symbol(symbol):
+                    if to_symbol(symbol) == Epsilon():
+                        continue
+                    return False
+                next_state = bitset_nfa.step(current, symbol)
+                transitions[symbol] = next_state
+            if not next_state:
+                return False
+            current = next_state
+            transitions = self._get_transitions(current)
+        return bitset_nfa.is_final_mask(current)
@@ -0,0 +1,232 @@
+"""
+An intersection of automata whose product is explored on demand
+"""
+
+from collections import deque
+from itertools import product
+from typing import Iterable, Any, List, Optional, Tuple, Dict
+
+from .bitset_nfa import iterate_bits
+from .state import State
+from .symbol import Symbol
+
+ProductState = Tuple[int, ...]
+
+
+class LazyIntersection:
+    """ The intersection of several epsilon NFAs, seen as their product \
+    automaton without building it.
+
+    The states of the product are tuples made of one state of each \
+    automaton, reached by the same word. They are only explored when a \
+    query needs them, and the queries stop as soon as the answer is \
+    known. The product of any number of automata is explored at once.
+
+    The intersection does not follow later modifications of the automata \
+    it was built from.
+
+    Parameters
+    ----------
+    automata : iterable of :class:`~pyformlang.finite_automaton.EpsilonNFA`
+        The automata to intersect, at least one
+
+    Examples
+    --------
+
+    >>> enfa0 = EpsilonNFA()
+    >>> enfa0.add_transitions([(0, "a", 0), (0, "b", 1)])
+    >>> enfa0.add_start_state(0)
+    >>> enfa0.add_final_state(1)
+    >>> enfa1 = EpsilonNFA()
+    >>> enfa1.add_transitions([(0, "a", 1), (1, "b", 2)])
+    >>> enfa1.add_start_state(0)
+    >>> enfa1.add_final_state(2)
+    >>> intersection = enfa0.get_lazy_intersection(enfa1)
+    >>> intersection.is_empty()
+    False
+    >>> intersection.accepts(["a", "b"])
+    True
+    >>> list(intersection.get_accepted_words())
+    [[a, b]]
+
+    """
+
+    def __init__(self, automata: Iterable[Any]):
+        # pylint: disable=protected-access
+        self._bitsets = [automaton._get_bitset_nfa() for automaton in automata]
+        if not self._bitsets:
+            raise ValueError("The intersection needs at least one automaton")
+        self._edges: Optional[List[List[Tuple[Any, int]]]] = None
+        self._states: List[ProductState] = []
+        self._n_starts = 0
+
+    def _get_start_states(self) -> Iterable[ProductState]:
+        return product(*[list(iterate_bits(bitset_nfa.start_mask))
+                         for bitset_nfa in self._bitsets])
+
+    def _is_final(self, state: ProductState) -> bool:
+        return all(bitset_nfa.is_final_mask(1 << index)
+                   for bitset_nfa, index in zip(self._bitsets, state))
+
+    def _get_successors(self, state: ProductState) \
+            -> Iterable[Tuple[Any, ProductState]]:
+        """ Gives the transitions leaving a state of the product, only \
+        trying the symbols leaving all its components """
+        successors = [bitset_nfa.get_state_successors(index)
+                      for bitset_nfa, index in zip(self._bitsets, state)]
+        smallest = min(successors, key=len)
+        for value in smallest:
+            masks = [successor.get(value, 0) for successor in successors]
+            if all(masks):
+                for next_state in product(*[list(iterate_bits(mask))
+                                            for mask in masks]):
+                    yield value, next_state
+
+    def accepts(self, word: Iterable[Any]) -> bool:
+        """ Checks whether all the automata accept a given word
+
+        Parameters
+        ----------
+        word : iterable of any
+            A sequence of symbols, or of their values
+
+        Returns
+        ----------
+        is_accepted : bool
+            Whether the word is accepted or not
+        """
+        word = list(word)
+        return all(bitset_nfa.accepts(word) for bitset_nfa in self._bitsets)
+
+    def is_empty(self) -> bool:
+        """ Checks whether no word is accepted by all the automata
+
+        The product is explored depth-first and the exploration stops at \
+        the first final state found.
+
+        Returns
+        ----------
+        is_empty : bool
+            Whether the intersection is empty
+        """
+        to_process = list(self._get_start_states())
+        processed = set(to_process)
+        while to_process:
+            current = to_process.pop()
+            if self._is_final(current):
+                return False
+            for _, next_state in self._get_successors(current):
+                if next_state not in processed:
+                    processed.add(next_state)
+                    to_process.append(next_state)
+        return True
+
+    def _explore(self):
+        """ Explores all the reachable states of the product, once """
+        if self._edges is not None:
+            return
+        indexes: Dict[ProductState, int] = {}
+        states = []
+        edges = []
+        for state in self._get_start_states():
+            if state not in indexes:
+                indexes[state] = len(states)
+                states.append(state)
+        self._n_starts = len(states)
+        current = 0
+        while current < len(states):
+            current_edges = []
+            for value, next_state in self._get_successors(states[current]):
+                if next_state not in indexes:
+                    indexes[next_state] = len(states)
+                    states.append(next_state)
+                current_edges.append((value, indexes[next_state]))
+            edges.append(current_edges)
+            current += 1
+        self._states = states
+        self._edges = edges
+
+    def _get_useful_states(self) -> List[bool]:
+        """ Gives, for each explored state, whether it can reach a final \
+        state """
+        self._explore()
+        previous = [[] for _ in self._states]
+        for source, current_edges in enumerate(self._edges):
+            for _, target in current_edges:
+                previous[target].append(source)
+        useful = [self._is_final(state) for state in self._states]
+        to_process = [index for index, is_useful in enumerate(useful)
+                      if is_useful]
+        while to_process:
+            for source in previous[to_process.pop()]:
+                if not useful[source]:
+                    useful[source] = True
+                    to_process.append(source)
+        return useful
+
+    def _get_symbol(self, value: Any) -> Symbol:
+        return self._bitsets[0].get_symbol(value)
+
+    def get_accepted_words(self, max_length: Optional[int] = None) \
+            -> Iterable[List[Symbol]]:
+        """ Gives the words accepted by all the automata, by increasing \
+        length
+
+        Parameters
+        ----------
+        max_length : int, optional
+            The maximal length of the words, unbounded by default
+
+        Returns
+        ----------
+        words : generator of list of \
+        :class:`~pyformlang.finite_automaton.Symbol`
+            The accepted words, each given once
+        """
+        useful = self._get_useful_states()
+        start = frozenset(index for index in range(self._n_starts)
+                          if useful[index])
+        if not start:
+            return
+        to_process = deque([(start, [])])
+        while to_process:
+            current, word = to_process.popleft()
+            if any(self._is_final(self._states[index]) for index in current):
+                yield word
+            if max_length is not None and len(word) >= max_length:
+                continue
+            next_sets: Dict[Any, set] = {}
+            for index in current:
+                for value, target in self._edges[index]:
+                    if useful[target]:
+                        next_sets.setdefault(value, set()).add(target)
+            for value, next_set in next_sets.items():
+                to_process.append((frozenset(next_set),
+                                   word + [self._get_symbol(value)]))
+
+    def to_epsilon_nfa(self):
+        """ Builds the product automaton
+
+        Returns
+        ----------
+        enfa : :class:`~pyformlang.finite_automaton.EpsilonNFA`
+            An automaton accepting the intersection. Its states are tuples \
+            of the values of the states of the intersected automata.
+        """
+        # pylint: disable=cyclic-import, import-outside-toplevel
+        from .epsilon_nfa import EpsilonNFA
+        self._explore()
+        names = [State(tuple(bitset_nfa.get_state(index).value
+                             for bitset_nfa, index in zip(self._bitsets,
+                                                          state)))
+                 for state in self._states]
+        enfa = EpsilonNFA()
+        for index in range(self._n_starts):
+            enfa.add_start_state(names[index])
+        for index, state in enumerate(self._states):
+            if self._is_final(state):
+                enfa.add_final_state(names[index])
+            for value, target in self._edges[index]:
+                enfa.add_transition(names[index], self._get_symbol(value),
+                                    names[target])
+        return enfa
@@ -0,0 +1,150 @@
+"""
+Matchers reading a word one symbol at a time
+"""
+
+from typing import Iterable, Any
+
+from .epsilon import Epsilon
+from .finite_automaton import to_symbol
+
+
+class Matcher:
+    """ Reads a word one symbol at a time, telling at each step whether \
+    the symbols read so far are accepted by an automaton
+
+    After reading a word, the matcher is accepting exactly when the \
+    automaton accepts the word. A matcher is dead when no continuation of \
+    the symbols read can be accepted, so a stream can be dropped as soon \
+    as its matcher is dead.
+
+    The matcher does not follow later modifications of the automaton it \
+    was built from. Matchers are built by \
+    :meth:`~pyformlang.finite_automaton.EpsilonNFA.matcher`.
+    """
+
+    def feed(self, symbol: Any) -> bool:
+        """ Reads a symbol
+
+        Parameters
+        ----------
+        symbol : any
+            The symbol, or its value
+
+        Returns
+        ----------
+        is_alive : bool
+            Whether a continuation can still be accepted
+        """
+        raise NotImplementedError
+
+    def feed_many(self, symbols: Iterable[Any]) -> bool:
+        """ Reads symbols, stopping as soon as the matcher is dead
+
+        The symbols after the one killing the matcher are not read from \
+        the iterable.
+
+        Parameters
+        ----------
+        symbols : iterable of any
+            The symbols, or their values
+
+        Returns
+        ----------
+        is_alive : bool
+            Whether a continuation can still be accepted
+        """
+        if self.is_dead():
+            return False
+        for symbol in symbols:
+            if not self.feed(symbol):
+                return False
+        return True
+
+    def is_accepting(self) -> bool:
+        """ Whether the symbols read so far form an accepted word """
+        raise NotImplementedError
+
+    def is_dead(self) -> bool:
+        """ Whether no continuation of the symbols read so far can be \
+        accepted """
+        raise NotImplementedError
+
+    def reset(self):
+        """ Forgets the symbols read, going back to the start """
+        raise NotImplementedError
+
+
+class BitsetMatcher(Matcher):
+    """ A matcher for a nondeterministic automaton, whose current states \
+    are kept as a bitset
+
+    For internal usage. Use \
+    :meth:`~pyformlang.finite_automaton.EpsilonNFA.matcher` instead.
+
+    Parameters
+    ----------
+    bitset_nfa : :class:`~pyformlang.finite_automaton.bitset_nfa.BitsetNFA`
+        The automaton
+    useful_mask : int
+        The states from which a final state can be reached, as a bitset
+    skip_epsilon : bool
+        Whether epsilon symbols are ignored or kill the matcher
+    """
+
+    def __init__(self, bitset_nfa, useful_mask: int, skip_epsilon: bool):
+        self._bitset_nfa = bitset_nfa
+        self._useful_mask = useful_mask
+        self._skip_epsilon = skip_epsilon
+        self._current = bitset_nfa.start_mask
+
+    def feed(self, symbol: Any) -> bool:
+        if not self._bitset_nfa.has_symbol(symbol) and self._skip_epsilon \
+                and to_symbol(symbol) == Epsilon():
+            return not self.is_dead()
+        self._current = self._bitset_nfa.step(self._current, symbol)
+        return not self.is_dead()
+
+    def is_accepting(self) -> bool:
+        return self._bitset_nfa.is_final_mask(self._current)
+
+    def is_dead(self) -> bool:
+        return not self._current & self._useful_mask
+
+    def reset(self):
+        self._current = self._bitset_nfa.start_mask
+
+
+class CompiledMatcher(Matcher):
+    """ A matcher for a deterministic automaton, whose current state is an \
+    index in a compiled transition table
+
+    For internal usage. Use \
+    :meth:`~pyformlang.finite_automaton.DeterministicFiniteAutomaton\
+.matcher` instead.
+
+    Parameters
+    ----------
+    compiled_dfa : :class:`~pyformlang.finite_automaton.CompiledDFA`
+        The automaton
+    useful : list of bool
+        For each state id, whether a final state can be reached from it
+    """
+
+    def __init__(self, compiled_dfa, useful):
+        self._compiled_dfa = compiled_dfa
+        self._useful = useful
+        self._current = compiled_dfa.start_index
+
+    def feed(self, symbol: Any) -> bool:
+        self._current = self._compiled_dfa.get_next_index(self._current,
+                                                          symbol)
+        return self._useful[self._current]
+
+    def is_accepting(self) -> bool:
+        return self._compiled_dfa.is_final_index(self._current)
+
+    def is_dead(self) -> bool:
+        return not self._useful[self._current]
+
+    def reset(self):
+        self._current = self._compiled_dfa.start_index
@@ -8,7 +8,9 @@ from typing import Iterable, Any
 from pyformlang.finite_automaton import epsilon
 from .epsilon_nfa import EpsilonNFA
 from .finite_automaton import to_symbol
+from .symbol import Symbol
 from .transition_function import InvalidEpsilonTransition
+from .matcher import Matcher
 
 
 class NondeterministicFiniteAutomaton(EpsilonNFA):
@@ -84,12 +86,20 @@ class NondeterministicFiniteAutomaton(EpsilonNFA):
         True
 
         """
-        word = [to_symbol(x) for x in word]
-        current_states = self._start_state
-        for symbol in word:
-            current_states = self._get_next_states_iterable(current_states,
-                                                            symbol)
-        return any(self.is_final_state(x) for x in current_states)
+        return self._get_bitset_nfa().accepts(word, skip_epsilon=False)
+
+    def matcher(self) -> Matcher:
+        """ Gives a matcher reading words one symbol at a time, for \
+        streams of symbols
+
+        As in :meth:`accepts`, an epsilon symbol kills the matcher.
+
+        Returns
+        ----------
+        matcher : :class:`~pyformlang.finite_automaton.Matcher`
+            A matcher at the start of the automaton
+        """
+        return self._get_bitset_matcher(skip_epsilon=False)
 
     def is_deterministic(self) -> bool:
         """ Checks whether an automaton is deterministic
@@ -134,7 +144,7 @@ class NondeterministicFiniteAutomaton(EpsilonNFA):
         True
 
         """
-        return self._to_deterministic_internal(False)
+        return self._to_deterministic_internal()
 
     def add_transition(self,
                        s_from: Any,
@@ -143,3 +153,9 @@ class NondeterministicFiniteAutomaton(EpsilonNFA):
         if symb_by == epsilon.Epsilon():
             raise InvalidEpsilonTransition
         return super().add_transition(s_from, symb_by, s_to)
+
+    def _to_transition_symbol(self, given: Any) -> Symbol:
+        symbol = to_symbol(given)
+        if symbol == epsilon.Epsilon():
+            raise InvalidEpsilonTransition
+        return symbol
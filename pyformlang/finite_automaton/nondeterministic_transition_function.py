@@ -6,6 +6,8 @@ from typing import Set, Iterable, Tuple
 
 from .state import State
 from .symbol import Symbol
+from .transition_function import add_to_index, remove_from_index, \
+    get_from_index
 
 
 class NondeterministicTransitionFunction:
@@ -14,6 +16,10 @@ class NondeterministicTransitionFunction:
     The difference with a deterministic transition is that the return value is
     a set of States
 
+    The transitions are indexed both by their source and by their \
+    destination, so the edges leaving or entering a state can be iterated \
+    without going through all the symbols.
+
     Examples
     --------
 
@@ -26,6 +32,7 @@ class NondeterministicTransitionFunction:
 
     def __init__(self):
         self._transitions = {}
+        self._incoming = {}
 
     def add_transition(self, s_from: State, symb_by: Symbol,
                        s_to: State) -> int:
@@ -53,16 +60,55 @@ class NondeterministicTransitionFunction:
         >>> transition.add_transition(State(0), Symbol("a"), State(1))
 
         """
-        if s_from in self._transitions:
-            if symb_by in self._transitions[s_from]:
-                self._transitions[s_from][symb_by].add(s_to)
-            else:
-                self._transitions[s_from][symb_by] = {s_to}
-        else:
-            self._transitions[s_from] = {}
-            self._transitions[s_from][symb_by] = {s_to}
+        add_to_index(self._transitions, s_from, symb_by, s_to)
+        add_to_index(self._incoming, s_to, symb_by, s_from)
         return 1
 
+    # pylint: disable=duplicate-code
+    def add_transitions(self,
+                        transitions: Iterable[Tuple[State, Symbol, State]]):
+        """ Adds several transitions at once, without the checks of \
+        add_transition
+
+        Parameters
+        ----------
+        transitions : iterable of (:class:`~pyformlang.finite_automaton\
+        .State`, :class:`~pyformlang.finite_automaton.Symbol`, \
+        :class:`~pyformlang.finite_automaton.State`)
+            The transitions to add
+
+        Examples
+        --------
+
+        >>> transition = NondeterministicTransitionFunction()
+        >>> transition.add_transitions([(State(0), Symbol("a"), State(1)), \
+        (State(0), Symbol("a"), State(2))])
+        >>> transition.get_number_transitions()
+        2
+
+        """
+        # The indexes are filled inline, as this is the hot loop when
+        # loading large automata
+        outgoing = self._transitions
+        incoming = self._incoming
+        for s_from, symb_by, s_to in transitions:
+            by_symbol = outgoing.get(s_from)
+            if by_symbol is None:
+                by_symbol = outgoing[s_from] = {}
+            states_to = by_symbol.get(symb_by)
+            if states_to is None:
+                by_symbol[symb_by] = {s_to}
+            else:
+                states_to.add(s_to)
+            by_symbol = incoming.get(s_to)
+            if by_symbol is None:
+                by_symbol = incoming[s_to] = {}
+            states_from = by_symbol.get(symb_by)
+            if states_from is None:
+                by_symbol[symb_by] = {s_from}
+            else:
+                states_from.add(s_from)
+
     def remove_transition(self, s_from: State, symb_by: Symbol,
                           s_to: State) -> int:
         """ Removes a transition to the function
@@ -93,7 +139,8 @@ class NondeterministicTransitionFunction:
         if s_from in self._transitions and \
                 symb_by in self._transitions[s_from] and \
                 s_to in self._transitions[s_from][symb_by]:
-            self._transitions[s_from][symb_by].remove(s_to)
+            remove_from_index(self._transitions, s_from, symb_by, s_to)
+            remove_from_index(self._incoming, s_to, symb_by, s_from)
             return 1
         return 0
 
@@ -205,7 +252,35 @@ class NondeterministicTransitionFunction:
     def get_transitions_from(self, state_from: State) \
             -> Iterable[Tuple[Symbol, State]]:
         """ Gets transitions from the given state """
-        if state_from in self._transitions:
-            for symb_by, states_to in self._transitions[state_from].items():
-                for state_to in states_to:
-                    yield symb_by, state_to
+        yield from get_from_index(self._transitions, state_from)
+
+    def get_symbols_from(self, state_from: State) -> Iterable[Symbol]:
+        """ Gets the symbols of the transitions leaving a state
+
+        Parameters
+        ----------
+        state_from : :class:`~pyformlang.finite_automaton.State`
+            The source state
+
+        Returns
+        ----------
+        symbols : iterable of :class:`~pyformlang.finite_automaton.Symbol`
+            A view on the symbols having at least one transition from the \
+            state
+
+        Examples
+        --------
+
+        >>> transition = NondeterministicTransitionFunction()
+        >>> transition.add_transition(State(0), Symbol("a"), State(1))
+        >>> list(transition.get_symbols_from(State(0)))
+        [a]
+
+        """
+        return self._transitions.get(state_from, {}).keys()
+
+    def get_transitions_to(self, state_to: State) \
+            -> Iterable[Tuple[Symbol, State]]:
+        """ Gets transitions to the given state, as pairs of symbol and \
+        source state """
+        yield from get_from_index(self._incoming, state_to)
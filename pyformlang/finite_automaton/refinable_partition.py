@@ -0,0 +1,116 @@
+"""
+A partition of integers which can be refined efficiently
+"""
+
+from typing import Iterable, List
+
+
+class RefinablePartition:
+    """ A partition of the integers from 0 to n - 1, stored in flat arrays.
+
+    The elements are kept in a single array where each set occupies a \
+    contiguous range. Refining consists in marking elements and then \
+    splitting each set containing marked elements in two, the new set \
+    being always the smaller part. This is the structure of Valmari and \
+    Lehtinen, used by the minimization algorithms.
+
+    For internal usage.
+
+    Parameters
+    ----------
+    n_elements : int
+        The number of elements, all in the same set at the beginning
+    """
+
+    def __init__(self, n_elements: int):
+        self.elements = list(range(n_elements))
+        self.locations = list(range(n_elements))
+        self.set_ids = [0] * n_elements
+        self.firsts = [0]
+        self.ends = [n_elements]
+        self._mids = [0]
+        self._touched = []
+        if n_elements == 0:
+            self.firsts = []
+            self.ends = []
+            self._mids = []
+
+    def __len__(self):
+        """ The number of sets """
+        return len(self.firsts)
+
+    def get_set(self, set_id: int) -> List[int]:
+        """ Gives a copy of the elements of a set """
+        return self.elements[self.firsts[set_id]:self.ends[set_id]]
+
+    def get_sets(self) -> List[List[int]]:
+        """ Gives all the sets """
+        return [self.get_set(set_id) for set_id in range(len(self))]
+
+    def mark_all(self, to_mark: Iterable[int]):
+        """ Marks elements, they will be separated from the unmarked ones \
+        at the next split
+
+        Parameters
+        ----------
+        to_mark : iterable of int
+            The elements to mark, possibly with repetitions
+        """
+        elements = self.elements
+        locations = self.locations
+        set_ids = self.set_ids
+        mids = self._mids
+        firsts = self.firsts
+        touched = self._touched
+        for element in to_mark:
+            set_id = set_ids[element]
+            location = locations[element]
+            mid = mids[set_id]
+            if location < mid:
+                # Already marked
+                continue
+            if mid == firsts[set_id]:
+                touched.append(set_id)
+            other = elements[mid]
+            elements[location] = other
+            locations[other] = location
+            elements[mid] = element
+            locations[element] = mid
+            mids[set_id] = mid + 1
+
+    def split(self) -> List[int]:
+        """ Splits the sets containing marked elements
+
+        Returns
+        ----------
+        new_sets : list of int
+            The ids of the created sets, each being the smaller part of the \
+            set it comes from
+        """
+        new_sets = []
+        firsts = self.firsts
+        ends = self.ends
+        mids = self._mids
+        set_ids = self.set_ids
+        elements = self.elements
+        while self._touched:
+            set_id = self._touched.pop()
+            mid = mids[set_id]
+            if mid == ends[set_id]:
+                mids[set_id] = firsts[set_id]
+                continue
+            new_set = len(firsts)
+            if mid - firsts[set_id] <= ends[set_id] - mid:
+                firsts.append(firsts[set_id])
+                ends.append(mid)
+                firsts[set_id] = mid
+            else:
+                firsts.append(mid)
+                ends.append(ends[set_id])
+                ends[set_id] = mid
+            mids[set_id] = firsts[set_id]
+            mids.append(firsts[new_set])
+            for location in range(firsts[new_set], ends[new_set]):
+                set_ids[elements[location]] = new_set
+            new_sets.append(new_set)
+        return new_sets
@@ -0,0 +1,270 @@
+"""
+Conversion of an automaton into a regular expression by state elimination
+"""
+
+import heapq
+from itertools import chain
+from typing import Dict, List, Tuple, Any
+
+from .epsilon import Epsilon
+
+# The labels of the edges during the elimination are light terms, turned into
+# a Regex only at the end:
+#   EPSILON
+#   ("symbol", value)
+#   ("star", label)
+#   ("concatenation", (label, ...)), with at least two labels
+#   ("union", (label, ...)), with at least two labels
+EPSILON = ("epsilon",)
+Label = Tuple[Any, ...]
+
+
+def _concatenate(labels: List[Label]) -> Label:
+    """ Concatenates labels, flattening the nested concatenations """
+    parts = []
+    for label in labels:
+        if label is EPSILON:
+            continue
+        if label[0] == "concatenation":
+            parts.extend(label[1])
+        else:
+            parts.append(label)
+    if not parts:
+        return EPSILON
+    if len(parts) == 1:
+        return parts[0]
+    return "concatenation", tuple(parts)
+
+
+def _union(label0: Label, label1: Label) -> Label:
+    """ Makes the union of two labels, flattening the nested unions """
+    if label0 is label1:
+        return label0
+    parts = []
+    for label in (label0, label1):
+        if label[0] == "union":
+            parts.extend(label[1])
+        else:
+            parts.append(label)
+    return "union", tuple(parts)
+
+
+def _star(label: Label) -> Label:
+    """ Makes the Kleene star of a label """
+    if label is EPSILON or label[0] == "star":
+        return label
+    return "star", label
+
+
+class _Elimination:
+    """ A generalized automaton whose states are numbered and whose \
+    transitions are labelled by regular expressions
+
+    For internal usage.
+    """
+
+    def __init__(self, n_states: int):
+        self.outgoing: List[Dict[int, Label]] = [{} for _ in range(n_states)]
+        self.incoming: List[Dict[int, Label]] = [{} for _ in range(n_states)]
+
+    def add_edge(self, source: int, label: Label, target: int):
+        """ Adds an edge, merged with the existing one by union """
+        previous = self.outgoing[source].get(target)
+        if previous is not None:
+            label = _union(previous, label)
+        self.outgoing[source][target] = label
+        self.incoming[target][source] = label
+
+    def get_weight(self, state: int) -> int:
+        """ The number of edges created by the elimination of a state """
+        n_in = len(self.incoming[state]) - (state in self.incoming[state])
+        n_out = len(self.outgoing[state]) - (state in self.outgoing[state])
+        return n_in * n_out
+
+    def remove(self, state: int):
+        """ Removes a state and its edges """
+        for source in self.incoming[state]:
+            del self.outgoing[source][state]
+        for target in self.outgoing[state]:
+            del self.incoming[target][state]
+        self.outgoing[state] = {}
+        self.incoming[state] = {}
+
+    def eliminate(self, state: int):
+        """ Removes a state, bypassing it with new edges """
+        outgoing = self.outgoing[state]
+        incoming = self.incoming[state]
+        loop = outgoing.pop(state, None)
+        incoming.pop(state, None)
+        middle = EPSILON if loop is None else _star(loop)
+        self.remove(state)
+        for source, label_in in incoming.items():
+            for target, label_out in outgoing.items():
+                self.add_edge(source,
+                              _concatenate([label_in, middle, label_out]),
+                              target)
+
+    def get_neighbours(self, state: int) -> List[int]:
+        """ The states linked to a state """
+        return list(set(self.outgoing[state]).union(self.incoming[state]))
+
+    def eliminate_all(self, states: List[int]):
+        """ Eliminates states, those creating the fewest edges first """
+        weights = {state: self.get_weight(state) for state in states}
+        heap = [(weight, state) for state, weight in weights.items()]
+        heapq.heapify(heap)
+        while heap:
+            weight, state = heapq.heappop(heap)
+            if weights.get(state) != weight:
+                # Outdated entry, or state already eliminated
+                continue
+            del weights[state]
+            neighbours = self.get_neighbours(state)
+            self.eliminate(state)
+            for neighbour in neighbours:
+                if neighbour in weights:
+                    new_weight = self.get_weight(neighbour)
+                    if new_weight != weights[neighbour]:
+                        weights[neighbour] = new_weight
+                        heapq.heappush(heap, (new_weight, neighbour))
+
+
+def _get_useful_states(elimination: _Elimination, start: int, final: int) \
+        -> List[bool]:
+    """ The states reachable from the start which can reach the final \
+    state """
+    reachable = [False] * len(elimination.outgoing)
+    reachable[start] = True
+    to_process = [start]
+    while to_process:
+        for target in elimination.outgoing[to_process.pop()]:
+            if not reachable[target]:
+                reachable[target] = True
+                to_process.append(target)
+    useful = [False] * len(elimination.outgoing)
+    if reachable[final]:
+        useful[final] = True
+        to_process = [final]
+    while to_process:
+        for source in elimination.incoming[to_process.pop()]:
+            if reachable[source] and not useful[source]:
+                useful[source] = True
+                to_process.append(source)
+    return useful
+
+
+def _to_regex(label: Label):
+    """ Turns a label into a Regex, the flat concatenations and unions \
+    becoming balanced trees. Shared labels give shared sub-expressions. """
+    # pylint: disable=import-outside-toplevel, cyclic-import
+    from pyformlang.regular_expression import Regex
+    from pyformlang.regular_expression import regex_objects
+    converted: Dict[int, Any] = {}
+
+    def get_sons(current: Label) -> List[Label]:
+        if current[0] == "star":
+            return [current[1]]
+        if current[0] in ("concatenation", "union"):
+            return list(current[1])
+        return []
+
+    def combine(parts: List[Any], combiner) -> Any:
+        while len(parts) > 1:
+            parts = [combiner(parts[i], parts[i + 1])
+                     if i + 1 < len(parts) else parts[i]
+                     for i in range(0, len(parts), 2)]
+        return parts[0]
+
+    to_process = [(label, False)]
+    while to_process:
+        current, sons_done = to_process.pop()
+        if id(current) in converted:
+            continue
+        if not sons_done:
+            to_process.append((current, True))
+            to_process.extend((son, False) for son in get_sons(current)
+                              if id(son) not in converted)
+            continue
+        if current is EPSILON:
+            regex = Regex("$")
+        elif current[0] == "symbol":
+            regex = Regex.from_node(regex_objects.Symbol(current[1]))
+        elif current[0] == "star":
+            regex = converted[id(current[1])].kleene_star()
+        elif current[0] == "concatenation":
+            regex = combine([converted[id(son)] for son in current[1]],
+                            Regex.concatenate)
+        else:
+            regex = combine([converted[id(son)] for son in current[1]],
+                            Regex.union)
+        converted[id(current)] = regex
+    return converted[id(label)]
+
+
+def get_regex(enfa):
+    """ Gives a regular expression equivalent to an epsilon NFA
+
+    A new start state and a new final state are linked to the automaton by \
+    epsilon transitions, then the other states are eliminated one by one. \
+    The next state to eliminate is always one creating the fewest new \
+    edges, i.e. minimizing the product of its numbers of predecessors and \
+    successors. The labels of the edges are regular expression trees, so \
+    nothing is ever parsed, and the sub-expressions are shared between the \
+    edges using them.
+
+    Parameters
+    ----------
+    enfa : :class:`~pyformlang.finite_automaton.EpsilonNFA`
+        The automaton
+
+    Returns
+    ----------
+    regex : :class:`~pyformlang.regular_expression.Regex`
+        A regular expression accepting the language of the automaton
+    """
+    elimination, n_states = _get_elimination(enfa)
+    start = n_states
+    final = n_states + 1
+    useful = _get_useful_states(elimination, start, final)
+    if not useful[final]:
+        # pylint: disable=import-outside-toplevel, cyclic-import
+        from pyformlang.regular_expression import Regex
+        return Regex("")
+    for state in range(n_states):
+        if not useful[state]:
+            elimination.remove(state)
+    elimination.eliminate_all([state for state in range(n_states)
+                               if useful[state]])
+    return _to_regex(elimination.outgoing[start][final])
+
+
+def _get_elimination(enfa) -> Tuple[_Elimination, int]:
+    """ Builds the generalized automaton of an epsilon NFA, with its states \
+    numbered from 0 to n - 1, n being the new start state and n + 1 the new \
+    final state """
+    # pylint: disable=protected-access
+    edges = list(enfa._transition_function.get_edges())
+    # The transition function may hold states which were never registered
+    # in the automaton
+    indexes = {}
+    for state in chain(enfa.states,
+                       (s_from for s_from, _, _ in edges),
+                       (s_to for _, _, s_to in edges)):
+        indexes.setdefault(state, len(indexes))
+    start = len(indexes)
+    final = start + 1
+    elimination = _Elimination(len(indexes) + 2)
+    symbols = {}
+    for s_from, symbol, s_to in edges:
+        if symbol == Epsilon():
+            label = EPSILON
+        else:
+            label = symbols.get(symbol)
+            if label is None:
+                label = symbols[symbol] = ("symbol", symbol.value)
+        elimination.add_edge(indexes[s_from], label, indexes[s_to])
+    for state in enfa.start_states:
+        elimination.add_edge(start, EPSILON, indexes[state])
+    for state in enfa.final_states:
+        elimination.add_edge(indexes[state], EPSILON, final)
+    return elimination, len(indexes)
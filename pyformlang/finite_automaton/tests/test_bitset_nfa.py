@@ -0,0 +1,104 @@
+"""
+Tests for the bit-parallel simulation of nondeterministic automata
+"""
+from pyformlang.finite_automaton import EpsilonNFA, \
+    NondeterministicFiniteAutomaton, State, Symbol, Epsilon
+from pyformlang.finite_automaton.bitset_nfa import BitsetNFA
+
+
+class TestBitsetNFA:
+    """ Tests for the bit-parallel simulation of nondeterministic automata
+    """
+
+    # pylint: disable=missing-function-docstring,protected-access
+
+    def test_accepts(self):
+        bitset_nfa = BitsetNFA(get_example())
+        assert bitset_nfa.accepts(["a", "b", "c"])
+        assert bitset_nfa.accepts(["a", "c"])
+        assert bitset_nfa.accepts([Symbol("a"), Symbol("c")])
+        assert bitset_nfa.accepts(["a", "epsilon", Epsilon(), "c"])
+        assert not bitset_nfa.accepts(["a", "epsilon", "c"],
+                                      skip_epsilon=False)
+        assert not bitset_nfa.accepts(["a"])
+        assert not bitset_nfa.accepts(["a", "d"])
+        assert not bitset_nfa.accepts([])
+
+    def test_masks(self):
+        enfa = get_example()
+        bitset_nfa = BitsetNFA(enfa)
+        start = bitset_nfa.start_mask
+        assert bitset_nfa.get_states(start) == {State(0)}
+        after_a = bitset_nfa.step(start, "a")
+        assert bitset_nfa.get_states(after_a) == {State(1), State(2)}
+        assert after_a == bitset_nfa.get_closure_mask(1)
+        assert set(bitset_nfa.get_symbols_from(after_a)) == {"b", "c"}
+        assert set(bitset_nfa.get_symbols()) == {"a", "b", "c"}
+        assert bitset_nfa.step(after_a, "a") == 0
+        after_c = bitset_nfa.step(after_a, "c")
+        assert bitset_nfa.is_final_mask(after_c)
+        assert after_c == 1 << bitset_nfa.get_index(3)
+        assert bitset_nfa.final_mask == after_c
+
+    def test_cache_invalidation(self):
+        enfa = get_example()
+        assert not enfa.accepts(["a", "d"])
+        cached = enfa._get_bitset_nfa()
+        assert enfa._get_bitset_nfa() is cached
+        enfa.add_transition(2, "d", 3)
+        assert enfa.accepts(["a", "d"])
+        enfa.remove_final_state(3)
+        assert not enfa.accepts(["a", "d"])
+        enfa.add_final_state(1)
+        assert enfa.accepts(["a"])
+        enfa.remove_start_state(0)
+        assert not enfa.accepts(["a"])
+        enfa.add_start_state(1)
+        assert enfa.accepts([])
+
+    def test_nfa(self):
+        nfa = NondeterministicFiniteAutomaton()
+        nfa.add_transitions([(0, "a", 1), (0, "a", 2), (2, "b", 2)])
+        nfa.add_start_state(0)
+        nfa.add_final_state(2)
+        assert nfa.accepts(["a", "b", "b"])
+        assert not nfa.accepts(["a", "epsilon"])
+        assert not nfa.accepts(["b"])
+
+    def test_big_union(self):
+        enfa = EpsilonNFA()
+        enfa.add_start_state("start")
+        for i in range(200):
+            enfa.add_transition("start", "epsilon", (i, 0))
+            for j in range(i):
+                enfa.add_transition((i, j), "a", (i, j + 1))
+            enfa.add_final_state((i, i))
+        assert enfa.accepts(["a"] * 150)
+        assert not enfa.accepts(["a"] * 250)
+
+    def test_minterms(self):
+        enfa = EpsilonNFA()
+        enfa.add_transitions([(0, "a", 1), (0, "b", 1), (0, "c", 1),
+                              (1, "a", 2), (1, "b", 2), (0, "d", 2),
+                              (0, "epsilon", 2)])
+        bitset_nfa = BitsetNFA(enfa)
+        minterms = sorted(sorted(minterm)
+                          for minterm in bitset_nfa.get_minterms())
+        assert minterms == [["a", "b"], ["c"], ["d"]]
+        successors = bitset_nfa.get_minterm_successors(
+            bitset_nfa.get_closure_mask(0))
+        assert len(successors) == 3
+        for minterm, next_mask in successors.items():
+            for value in bitset_nfa.get_minterms()[minterm]:
+                assert bitset_nfa.step(bitset_nfa.get_closure_mask(0),
+                                       value) == next_mask
+
+
+def get_example():
+    """ Gives an epsilon nfa """
+    enfa = EpsilonNFA()
+    enfa.add_start_state(0)
+    enfa.add_final_state(3)
+    enfa.add_transitions([(0, "a", 1), (1, "epsilon", 2), (1, "b", 1),
+                          (2, "c", 3), (2, "b", 2)])
+    return enfa
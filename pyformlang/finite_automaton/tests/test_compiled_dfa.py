@@ -0,0 +1,86 @@
+"""
+Tests for the compiled deterministic finite automata
+"""
+from pyformlang.finite_automaton import DeterministicFiniteAutomaton, \
+    CompiledDFA, State, Symbol
+
+
+class TestCompiledDFA:
+    """ Tests for compiled deterministic finite automata
+    """
+
+    # pylint: disable=missing-function-docstring
+
+    def test_accepts(self):
+        compiled = get_example().compile()
+        assert isinstance(compiled, CompiledDFA)
+        assert compiled.accepts(["a", "c"])
+        assert compiled.accepts(["a", "b", "b", "d"])
+        assert compiled.accepts([Symbol("a"), Symbol("d")])
+        assert not compiled.accepts(["a"])
+        assert not compiled.accepts(["c"])
+        assert not compiled.accepts([])
+        assert not compiled.accepts(["a", "unknown"])
+        assert not compiled.accepts(["a", "epsilon", "c"])
+
+    def test_same_as_dfa(self):
+        dfa = get_example()
+        compiled = dfa.compile()
+        words = [["a", "c"], ["a"], ["a", "b", "c", "c"], ["b"],
+                 ["a", "b", "d"], []]
+        for word in words:
+            assert compiled.accepts(word) == dfa.accepts(word)
+
+    def test_match_many(self):
+        compiled = get_example().compile()
+        assert compiled.match_many([]) == []
+        assert compiled.match_many([["a", "c"], [], ["a", "x", "c"],
+                                    ["a", "b", "b", "b", "d"], ["a"]]) == \
+            [True, False, False, True, False]
+
+    def test_indexes(self):
+        dfa = get_example()
+        compiled = dfa.compile()
+        assert len(compiled) == 4
+        start = compiled.start_index
+        assert compiled.get_state(start) == State(0)
+        assert State(0).index is None
+        assert dfa.start_state.index == start
+        next_index = compiled.get_next_index(start, "a")
+        assert compiled.get_state(next_index) == State(1)
+        assert not compiled.is_final_index(next_index)
+        final_index = compiled.get_next_index(next_index, "c")
+        assert compiled.is_final_index(final_index)
+        dead = compiled.get_next_index(start, "c")
+        assert dead == compiled.dead_index
+        assert compiled.get_state(dead) is None
+        assert compiled.get_next_index(dead, "a") == dead
+        assert compiled.transition_table.shape == (5, 6)
+        assert compiled.final_table.sum() == 2
+
+    def test_no_start_state(self):
+        dfa = DeterministicFiniteAutomaton()
+        dfa.add_transition(0, "a", 1)
+        dfa.add_final_state(1)
+        compiled = dfa.compile()
+        assert not compiled.accepts(["a"])
+        assert not compiled.accepts([])
+        assert compiled.match_many([["a"], []]) == [False, False]
+
+    def test_frozen(self):
+        dfa = get_example()
+        compiled = dfa.compile()
+        dfa.add_transition(2, "e", 3)
+        assert dfa.accepts(["a", "c", "e"])
+        assert not compiled.accepts(["a", "c", "e"])
+
+
+def get_example():
+    """ Gives a dfa """
+    dfa = DeterministicFiniteAutomaton()
+    dfa.add_start_state(0)
+    dfa.add_final_state(2)
+    dfa.add_final_state(3)
+    dfa.add_transitions([(0, "a", 1), (1, "b", 1), (1, "c", 2),
+                         (1, "d", 3)])
+    return dfa
@@ -5,8 +5,11 @@ from pyformlang.finite_automaton import DeterministicFiniteAutomaton, Epsilon
 from pyformlang.finite_automaton import State
 from pyformlang.finite_automaton import Symbol
 from pyformlang.finite_automaton import TransitionFunction
+from pyformlang.finite_automaton import DuplicateTransitionError
 from pyformlang.finite_automaton.transition_function import \
     InvalidEpsilonTransition
+import random
+
 import pytest
 
 
@@ -226,6 +229,56 @@ class TestDeterministicFiniteAutomaton:
         dfa = dfa.minimize()
         assert dfa.accepts([symb_a, symb_star, symb_a])
 
+    def test_minimize_methods(self):
+        dfa = get_random_dfa(300, 3, 0)
+        generator = random.Random(0)
+        words = [[str(generator.randrange(3)) for _ in range(length)]
+                 for length in range(12) for _ in range(20)]
+        minimal = dfa.minimize()
+        legacy = dfa.minimize("legacy")
+        assert len(minimal.states) <= len(legacy.states)
+        assert len(legacy.states) <= len(minimal.states) + 1
+        for word in words:
+            assert dfa.accepts(word) == minimal.accepts(word)
+            assert dfa.accepts(word) == legacy.accepts(word)
+        assert len(minimal.minimize().states) == len(minimal.states)
+        with pytest.raises(ValueError):
+            dfa.minimize("unknown")
+
+    def test_minimize_valmari(self):
+        for seed in range(5):
+            dfa = get_random_dfa(200, 2 + seed * 10, seed)
+            hopcroft = dfa.minimize()
+            valmari = dfa.minimize("valmari")
+            assert len(valmari.states) == len(hopcroft.states)
+            assert valmari.get_number_transitions() == \
+                hopcroft.get_number_transitions()
+            assert valmari.is_equivalent_to(hopcroft)
+        dfa = get_example0()
+        assert len(dfa.minimize("valmari").states) == \
+            len(dfa.minimize().states)
+
+    def test_minimize_removes_useless_states(self):
+        dfa = DeterministicFiniteAutomaton()
+        dfa.add_start_state(0)
+        dfa.add_final_state(2)
+        dfa.add_final_state(4)
+        dfa.add_transitions([(0, "a", 1), (1, "b", 2), (0, "b", 3),
+                             (3, "b", 4), (0, "c", 5), (5, "c", 5),
+                             (6, "a", 2)])
+        minimal = dfa.minimize()
+        assert len(minimal.states) == 3
+        assert minimal.get_number_transitions() == 3
+        assert minimal.accepts(["a", "b"])
+        assert minimal.accepts(["b", "b"])
+        assert not minimal.accepts(["c"])
+        assert len(dfa.minimize("legacy").states) == 4
+        assert len(dfa.minimize("valmari").states) == 3
+        dfa.remove_final_state(2)
+        dfa.remove_final_state(4)
+        dfa.add_final_state(6)
+        assert dfa.minimize().is_empty()
+
     def test_not_cyclic(self):
         dfa = DeterministicFiniteAutomaton()
         state0 = State(0)
@@ -253,6 +306,37 @@ class TestDeterministicFiniteAutomaton:
         with pytest.raises(InvalidEpsilonTransition):
             dfa.add_transition(state0, Epsilon(), state1)
 
+    def test_from_edge_arrays(self):
+        dfa = DeterministicFiniteAutomaton.from_edge_arrays(
+            [0, 0, 1, 1], ["a", "b", "a", "a"], [1, 0, 1, 1],
+            start_states=[0], final_states=[1])
+        assert isinstance(dfa, DeterministicFiniteAutomaton)
+        assert dfa.get_number_transitions() == 3
+        assert dfa.accepts(["b", "a", "a"])
+        assert not dfa.accepts(["b"])
+        with pytest.raises(DuplicateTransitionError):
+            DeterministicFiniteAutomaton.from_edge_arrays(
+                [0, 0], ["a", "a"], [1, 2])
+        with pytest.raises(InvalidEpsilonTransition):
+            DeterministicFiniteAutomaton.from_edge_arrays(
+                [0], ["epsilon"], [1])
+
+    def test_refused_transitions_not_registered(self):
+        dfa = DeterministicFiniteAutomaton()
+        with pytest.raises(DuplicateTransitionError):
+            dfa.add_transitions([(0, "a", 1), (0, "a", 2), (3, "b", 4)])
+        assert dfa.states == {State(0), State(1)}
+        assert dfa.symbols == {Symbol("a")}
+        assert dfa.get_number_transitions() == 1
+        with pytest.raises(DuplicateTransitionError):
+            dfa.add_transitions([(1, "c", 0), (1, "c", 5)])
+        assert dfa.states == {State(0), State(1)}
+        assert dfa.symbols == {Symbol("a"), Symbol("c")}
+        with pytest.raises(InvalidEpsilonTransition):
+            dfa.add_transitions([(1, "d", 0), (5, "epsilon", 6)])
+        assert dfa.states == {State(0), State(1)}
+        assert dfa.get_number_transitions() == 2
+
     def test_cyclic(self):
         dfa = DeterministicFiniteAutomaton()
         state0 = State(0)
@@ -429,3 +513,18 @@ def get_dfa_example_without_accepted_words():
     dfa.add_start_state(states[0])
     dfa.add_final_state(states[3])
     return dfa
+
+
+def get_random_dfa(n_states, n_symbols, seed, final_probability=0.1):
+    """ Gives a random partial dfa, on the symbols 0 to n_symbols - 1 """
+    generator = random.Random(seed)
+    dfa = DeterministicFiniteAutomaton()
+    dfa.add_start_state(0)
+    for state in range(n_states):
+        for symbol in range(n_symbols):
+            if generator.random() < 0.7:
+                dfa.add_transition(state, str(symbol),
+                                   generator.randrange(n_states))
+        if generator.random() < final_probability:
+            dfa.add_final_state(state)
+    return dfa
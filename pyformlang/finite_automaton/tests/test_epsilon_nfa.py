@@ -2,8 +2,10 @@
 Tests for epsilon NFA
 """
 import copy
+import random
 
 import networkx
+import numpy
 
 from pyformlang.finite_automaton import EpsilonNFA, State, Symbol, Epsilon
 from ..regexable import Regexable
@@ -39,6 +41,63 @@ class TestEpsilonNFA:
                          1
         assert not enfa.is_deterministic()
 
+    def test_eclose_cycles(self):
+        enfa = EpsilonNFA()
+        enfa.add_transitions([(0, "epsilon", 1), (1, "epsilon", 2),
+                              (2, "epsilon", 0), (2, "epsilon", 3),
+                              (3, "epsilon", 4), (4, "epsilon", 3),
+                              (4, "a", 5), (5, "epsilon", 5)])
+        assert enfa.eclose(1) == {State(x) for x in range(5)}
+        assert enfa.eclose(4) == {State(3), State(4)}
+        assert enfa.eclose(5) == {State(5)}
+        assert enfa.eclose(6) == {State(6)}
+        assert enfa.eclose_iterable([4, 5]) == {State(3), State(4),
+                                                State(5)}
+        assert enfa._get_closure(State(0)) is enfa._get_closure(State(2))
+        closure = enfa.eclose(0)
+        closure.add(State(7))
+        assert State(7) not in enfa.eclose(0)
+        enfa.add_transition(3, "epsilon", 5)
+        assert enfa.eclose(1) == {State(x) for x in range(6)}
+        enfa.remove_transition(2, "epsilon", 3)
+        assert enfa.eclose(1) == {State(x) for x in range(3)}
+
+    def test_eclose_long_chain(self):
+        enfa = EpsilonNFA()
+        for i in range(5000):
+            enfa.add_transition(i, "epsilon", i + 1)
+        assert len(enfa.eclose(0)) == 5001
+        assert len(enfa.eclose(4000)) == 1001
+
+    def test_from_edge_arrays(self):
+        enfa = EpsilonNFA.from_edge_arrays(
+            numpy.array([0, 0, 1, 1]), ["a", "epsilon", "b", "b"],
+            numpy.array([1, 1, 2, 2]), start_states=[0], final_states=[2])
+        assert isinstance(enfa, EpsilonNFA)
+        assert enfa.get_number_transitions() == 3
+        assert enfa.states == {State(0), State(1), State(2)}
+        assert enfa.symbols == {Symbol("a"), Symbol("b")}
+        assert enfa.accepts(["b"])
+        assert enfa.accepts(["a", "b"])
+        assert not enfa.accepts(["a"])
+        assert all(isinstance(state.value, int) for state in enfa.states)
+        with pytest.raises(ValueError):
+            EpsilonNFA.from_edge_arrays([0, 1], ["a"], [1, 2])
+
+    def test_add_transitions_bulk(self):
+        enfa = EpsilonNFA()
+        enfa.add_transition(0, "a", 1)
+        enfa.add_start_state(0)
+        enfa.add_final_state(2)
+        assert enfa.add_transitions(
+            (i, Symbol("b") if i else Epsilon(), i + 1)
+            for i in range(1, 3)) == 1
+        assert enfa.add_transitions([]) == 0
+        assert enfa.accepts(["a", "b"])
+        assert enfa.get_number_transitions() == 3
+        assert len(list(enfa._transition_function.get_transitions_to(
+            State(2)))) == 1
+
     def test_accept(self):
         """ Test the acceptance """
         self._perform_tests_digits(False)
@@ -183,6 +242,67 @@ class TestEpsilonNFA:
                                        symb_b, symb_a, symb_b])
         assert not enfa2.accepts([symb_b])
 
+    def test_to_regex_special_symbols(self):
+        enfa = EpsilonNFA()
+        enfa.add_transitions([(0, "a+b", 1), (1, "(", 1), (1, 3, 2),
+                              (0, "epsilon", 2), (5, "c", 2)])
+        enfa.add_start_state(0)
+        enfa.add_final_state(2)
+        enfa2 = enfa.to_regex().to_epsilon_nfa()
+        assert enfa2.accepts([])
+        assert enfa2.accepts(["a+b", "(", "(", 3])
+        assert not enfa2.accepts(["a", "(", 3])
+        assert not enfa2.accepts(["c"])
+        assert "c" not in str(enfa.to_regex())
+
+    def test_to_regex_unregistered_states(self):
+        # pylint: disable=protected-access
+        enfa = EpsilonNFA()
+        enfa.add_start_state(0)
+        enfa.add_final_state(2)
+        enfa._transition_function.add_transition(
+            State(0), Symbol("a"), State(1))
+        enfa._transition_function.add_transition(
+            State(1), Symbol("b"), State(2))
+        assert State(1) not in enfa.states
+        enfa2 = enfa.to_regex().to_epsilon_nfa()
+        assert enfa2.accepts(["a", "b"])
+        assert not enfa2.accepts(["a"])
+
+    def test_to_regex_empty(self):
+        enfa = EpsilonNFA()
+        enfa.add_transitions([(0, "a", 1), (2, "b", 3)])
+        enfa.add_start_state(0)
+        enfa.add_final_state(3)
+        assert enfa.to_regex().to_epsilon_nfa().is_empty()
+        assert EpsilonNFA().to_regex().to_epsilon_nfa().is_empty()
+
+    def test_to_regex_random(self):
+        generator = random.Random(42)
+        for _ in range(10):
+            enfa = EpsilonNFA()
+            n_states = generator.randint(2, 15)
+            for state in range(n_states):
+                for symbol in ["a", "b", "epsilon"]:
+                    if generator.random() < 0.6:
+                        enfa.add_transition(
+                            state, symbol, generator.randrange(n_states))
+            enfa.add_start_state(0)
+            enfa.add_final_state(generator.randrange(n_states))
+            enfa.add_final_state(generator.randrange(n_states))
+            enfa2 = enfa.to_regex().to_epsilon_nfa()
+            assert enfa.is_equivalent_to(enfa2)
+
+    def test_to_regex_long_chain(self):
+        enfa = EpsilonNFA()
+        for i in range(2000):
+            enfa.add_transition(i, "a", i + 1)
+        enfa.add_start_state(0)
+        enfa.add_final_state(2000)
+        regex = enfa.to_regex()
+        assert regex.accepts(["a"] * 2000)
+        assert not regex.accepts(["a"] * 1999)
+
     def test_to_regex3(self):
         """ Tests the transformation to regex """
         enfa = EpsilonNFA()
@@ -327,6 +447,26 @@ class TestEpsilonNFA:
         assert not enfa.accepts([])
         assert not enfa.accepts([symb_a, symb_a, symb_b])
 
+    def test_intersection_after_removal(self):
+        """ Tests the intersection once transitions are removed """
+        enfa0 = EpsilonNFA()
+        enfa0.add_transitions([(0, "a", 1), (0, "b", 1), (1, "c", 2)])
+        enfa0.add_start_state(0)
+        enfa0.add_final_state(2)
+        enfa1 = EpsilonNFA()
+        enfa1.add_transitions([(0, "a", 1), (0, "b", 1), (1, "c", 1),
+                               (1, "epsilon", 2)])
+        enfa1.add_start_state(0)
+        enfa1.add_final_state(2)
+        assert (enfa0 & enfa1).accepts(["b", "c"])
+        enfa0.remove_transition(0, "b", 1)
+        enfa = enfa0 & enfa1
+        assert enfa.accepts(["a", "c"])
+        assert not enfa.accepts(["b", "c"])
+        assert enfa.get_number_transitions() == 4
+        assert ~enfa1 == ~enfa1.copy()
+        assert enfa1.reverse().accepts(["c", "c", "a"])
+
     def test_difference(self):
         """ Tests the intersection of two languages """
         enfa0 = get_enfa_example0()
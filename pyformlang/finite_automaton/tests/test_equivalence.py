@@ -0,0 +1,89 @@
+"""
+Tests for the equivalence checks
+"""
+from pyformlang.finite_automaton import DeterministicFiniteAutomaton, \
+    NondeterministicFiniteAutomaton, Symbol
+from pyformlang.finite_automaton.equivalence import get_dfa_counterexample, \
+    get_nfa_counterexample
+from pyformlang.finite_automaton.tests.test_deterministic_finite_automaton \
+    import get_random_dfa
+from pyformlang.finite_automaton.tests.test_lazy_dfa import get_nth_last_enfa
+
+
+class TestEquivalence:
+    """ Tests for the equivalence checks
+    """
+
+    # pylint: disable=missing-function-docstring
+
+    def test_dfa_equivalence(self):
+        dfa0 = get_parity_dfa(2)
+        dfa1 = get_parity_dfa(4)
+        assert dfa0.is_equivalent_to(dfa1)
+        assert get_dfa_counterexample(dfa0, dfa1) is None
+        dfa2 = get_parity_dfa(3)
+        counterexample = dfa0.get_equivalence_counterexample(dfa2)
+        assert counterexample == [Symbol("a")] * 3
+        assert dfa0.accepts(counterexample) != dfa2.accepts(counterexample)
+        assert not dfa0.is_equivalent_to(dfa2)
+
+    def test_partial_dfas(self):
+        dfa0 = DeterministicFiniteAutomaton()
+        dfa0.add_start_state(0)
+        dfa0.add_final_state(1)
+        dfa0.add_transition(0, "a", 1)
+        dfa1 = dfa0.copy()
+        dfa1.add_transitions([(0, "b", 2), (2, "b", 2)])
+        assert dfa0.is_equivalent_to(dfa1)
+        dfa1.add_final_state(2)
+        assert dfa0.get_equivalence_counterexample(dfa1) == [Symbol("b")]
+        assert not DeterministicFiniteAutomaton().is_equivalent_to(dfa0)
+        assert DeterministicFiniteAutomaton().is_equivalent_to(
+            DeterministicFiniteAutomaton())
+
+    def test_random_dfas(self):
+        for seed in range(30):
+            dfa0 = get_random_dfa(6, 2, 2 * seed, final_probability=0.3)
+            dfa1 = get_random_dfa(6, 2, 2 * seed + 1, final_probability=0.3)
+            counterexample = dfa0.get_equivalence_counterexample(dfa1)
+            minimal0 = dfa0.minimize()
+            minimal1 = dfa1.minimize()
+            if counterexample is None:
+                assert len(minimal0.states) == len(minimal1.states)
+                assert get_nfa_counterexample(dfa0, dfa1) is None
+            else:
+                assert dfa0.accepts(counterexample) != \
+                    dfa1.accepts(counterexample)
+                nfa_counterexample = get_nfa_counterexample(dfa0, dfa1)
+                assert dfa0.accepts(nfa_counterexample) != \
+                    dfa1.accepts(nfa_counterexample)
+            assert dfa0.is_equivalent_to(minimal0)
+            assert minimal1.is_equivalent_to(dfa1)
+
+    def test_nfa_equivalence(self):
+        enfa0 = get_nth_last_enfa(12)
+        enfa1 = get_nth_last_enfa(12, with_epsilon=True)
+        assert enfa0.is_equivalent_to(enfa1)
+        enfa2 = get_nth_last_enfa(11)
+        counterexample = enfa0.get_equivalence_counterexample(enfa2)
+        assert counterexample is not None
+        assert enfa0.accepts(counterexample) != enfa2.accepts(counterexample)
+        nfa = NondeterministicFiniteAutomaton()
+        nfa.add_transitions([(0, "a", 1), (0, "a", 2), (1, "b", 3)])
+        nfa.add_start_state(0)
+        nfa.add_final_state(3)
+        dfa = nfa.to_deterministic()
+        assert nfa.is_equivalent_to(dfa)
+        assert dfa.is_equivalent_to(nfa)
+        assert dfa.get_equivalence_counterexample(get_parity_dfa(2)) == []
+
+
+def get_parity_dfa(n_states):
+    """ Words of even length on a, with a cycle of n_states states """
+    dfa = DeterministicFiniteAutomaton()
+    dfa.add_start_state(0)
+    for state in range(n_states):
+        dfa.add_transition(state, "a", (state + 1) % n_states)
+        if state % 2 == 0:
+            dfa.add_final_state(state)
+    return dfa
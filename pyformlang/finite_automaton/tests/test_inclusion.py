@@ -0,0 +1,85 @@
+"""
+Tests for the inclusion and universality checks
+"""
+import itertools
+import random
+
+from pyformlang.finite_automaton import EpsilonNFA, Symbol
+from pyformlang.regular_expression import Regex
+from pyformlang.finite_automaton.tests.test_lazy_dfa import get_nth_last_enfa
+
+
+class TestInclusion:
+    """ Tests for the inclusion and universality checks
+    """
+
+    # pylint: disable=missing-function-docstring
+
+    def test_inclusion(self):
+        enfa0 = Regex("a b* c").to_epsilon_nfa()
+        enfa1 = Regex("a (b|c)*").to_epsilon_nfa()
+        assert enfa0.is_subset_of(enfa1)
+        assert enfa0.get_inclusion_counterexample(enfa1) is None
+        counterexample = enfa1.get_inclusion_counterexample(enfa0)
+        assert counterexample == [Symbol("a")]
+        assert not enfa1.is_subset_of(enfa0)
+        assert enfa0.is_subset_of(enfa0)
+        assert EpsilonNFA().is_subset_of(enfa0)
+        assert not enfa0.is_subset_of(EpsilonNFA())
+
+    def test_inclusion_without_determinization(self):
+        enfa0 = get_nth_last_enfa(15)
+        enfa1 = get_nth_last_enfa(15)
+        enfa1.add_transition(0, "b", 1)
+        assert enfa0.is_subset_of(enfa1)
+        counterexample = enfa1.get_inclusion_counterexample(enfa0)
+        assert counterexample is not None
+        assert enfa1.accepts(counterexample)
+        assert not enfa0.accepts(counterexample)
+
+    def test_random_inclusion(self):
+        generator = random.Random(3)
+        for _ in range(40):
+            enfa0 = get_random_enfa(generator, 5)
+            enfa1 = get_random_enfa(generator, 5)
+            counterexample = enfa0.get_inclusion_counterexample(enfa1)
+            # The states are few, so a counterexample would be short
+            words = [list(word) for length in range(8)
+                     for word in itertools.product("ab", repeat=length)]
+            has_counterexample = any(
+                enfa0.accepts(word) and not enfa1.accepts(word)
+                for word in words)
+            assert (counterexample is None) != has_counterexample
+            if counterexample is not None:
+                assert enfa0.accepts(counterexample)
+                assert not enfa1.accepts(counterexample)
+
+    def test_universality(self):
+        enfa = Regex("(a|b)*").to_epsilon_nfa()
+        assert enfa.is_universal()
+        enfa = Regex("(a|b)* a (a|b)*|b*").to_epsilon_nfa()
+        assert enfa.is_universal()
+        enfa = Regex("(a|b)* a").to_epsilon_nfa()
+        assert enfa.get_universality_counterexample() == []
+        enfa = Regex("$|(a|b)* a").to_epsilon_nfa()
+        assert enfa.get_universality_counterexample() == [Symbol("b")]
+        assert not EpsilonNFA().is_universal()
+        enfa = EpsilonNFA()
+        enfa.add_start_state(0)
+        enfa.add_final_state(0)
+        assert enfa.is_universal()
+
+
+def get_random_enfa(generator, n_states):
+    """ Gives a small random epsilon nfa on a, b """
+    enfa = EpsilonNFA()
+    enfa.add_start_state(0)
+    for state in range(n_states):
+        for symbol in ["a", "b", "epsilon"]:
+            for _ in range(2):
+                if generator.random() < 0.3:
+                    enfa.add_transition(state, symbol,
+                                        generator.randrange(n_states))
+        if generator.random() < 0.3:
+            enfa.add_final_state(state)
+    return enfa
@@ -0,0 +1,80 @@
+"""
+Tests for the deterministic automata built on demand
+"""
+from pyformlang.finite_automaton import EpsilonNFA, LazyDFA, State, Symbol
+
+
+class TestLazyDFA:
+    """ Tests for the deterministic automata built on demand
+    """
+
+    # pylint: disable=missing-function-docstring
+
+    def test_accepts(self):
+        lazy_dfa = LazyDFA(get_example())
+        assert lazy_dfa.accepts(["a", "b"])
+        assert lazy_dfa.accepts(["b", "a", "a", "b"])
+        assert lazy_dfa.accepts([Symbol("a"), "epsilon", Symbol("b")])
+        assert not lazy_dfa.accepts(["a", "b", "a"])
+        assert not lazy_dfa.accepts(["a", "c"])
+        assert not lazy_dfa.accepts([])
+        assert lazy_dfa.cache_size == 3
+
+    def test_states(self):
+        lazy_dfa = LazyDFA(get_example())
+        start = lazy_dfa.start_state
+        assert lazy_dfa.get_states(start) == {State(0)}
+        after_a = lazy_dfa.get_next_state(start, "a")
+        assert lazy_dfa.get_states(after_a) == {State(0), State(1)}
+        assert lazy_dfa.get_next_state(start, "a") == after_a
+        after_b = lazy_dfa.get_next_state(after_a, "b")
+        assert lazy_dfa.is_final(after_b)
+        assert not lazy_dfa.is_final(after_a)
+        assert lazy_dfa.get_next_state(start, "c") == 0
+        lazy_dfa.clear_cache()
+        assert lazy_dfa.cache_size == 0
+
+    def test_bounded_cache(self):
+        enfa = get_nth_last_enfa(8)
+        lazy_dfa = LazyDFA(enfa, max_cache_size=4)
+        word = ["a", "b"] * 20 + ["a"] + ["b"] * 7
+        assert lazy_dfa.accepts(word)
+        assert lazy_dfa.cache_size <= 4
+        assert not lazy_dfa.accepts(["a"] + ["b"] * 6)
+        assert enfa.accepts(word)
+
+    def test_same_as_determinization(self):
+        enfa = get_nth_last_enfa(3)
+        dfa = enfa.to_deterministic()
+        lazy_dfa = LazyDFA(enfa)
+        words = [["a", "a", "a"], ["a", "b", "b"], ["b", "a", "b", "a"],
+                 ["a", "a", "b", "b"], ["b"], []]
+        for word in words:
+            assert lazy_dfa.accepts(word) == dfa.accepts(word)
+        assert lazy_dfa.cache_size <= len(dfa.states)
+
+
+def get_example():
+    """ Words on a, b ending with ab """
+    enfa = EpsilonNFA()
+    enfa.add_transitions([(0, "a", 0), (0, "b", 0), (0, "a", 1),
+                          (1, "b", 2)])
+    enfa.add_start_state(0)
+    enfa.add_final_state(2)
+    return enfa
+
+
+def get_nth_last_enfa(n_letters, with_epsilon=False):
+    """ Words whose n-th letter from the end is an a, optionally read \
+    after an epsilon transition """
+    enfa = EpsilonNFA()
+    enfa.add_transitions([(0, "a", 0), (0, "b", 0)])
+    if with_epsilon:
+        enfa.add_transitions([(0, "epsilon", "pre"), ("pre", "a", 1)])
+    else:
+        enfa.add_transition(0, "a", 1)
+    for i in range(1, n_letters):
+        enfa.add_transitions([(i, "a", i + 1), (i, "b", i + 1)])
+    enfa.add_start_state(0)
+    enfa.add_final_state(n_letters)
+    return enfa
@@ -0,0 +1,68 @@
+"""
+Tests for the intersections explored on demand
+"""
+import pytest
+
+from pyformlang.finite_automaton import EpsilonNFA, LazyIntersection, \
+    State, Symbol
+from pyformlang.regular_expression import Regex
+
+
+class TestLazyIntersection:
+    """ Tests for the intersections explored on demand
+    """
+
+    # pylint: disable=missing-function-docstring
+
+    def test_binary(self):
+        enfa0 = Regex("a* b (a|b)*").to_epsilon_nfa()
+        enfa1 = Regex("(a a)* b").to_epsilon_nfa()
+        intersection = enfa0.get_lazy_intersection(enfa1)
+        assert not intersection.is_empty()
+        assert intersection.accepts(["a", "a", "b"])
+        assert not intersection.accepts(["a", "b"])
+        assert not intersection.accepts(["b", "b"])
+        words = list(intersection.get_accepted_words(max_length=4))
+        assert words == [[Symbol("b")], [Symbol("a")] * 2 + [Symbol("b")]]
+        enfa2 = Regex("a a*").to_epsilon_nfa()
+        assert enfa0.get_lazy_intersection(enfa2).is_empty()
+        assert not list(enfa0.get_lazy_intersection(enfa2)
+                        .get_accepted_words())
+
+    def test_n_ary(self):
+        automata = [get_multiple_enfa(modulo) for modulo in [2, 3, 5]]
+        intersection = LazyIntersection(automata)
+        assert not intersection.is_empty()
+        assert intersection.accepts(["a"] * 30)
+        assert not intersection.accepts(["a"] * 15)
+        words = intersection.get_accepted_words()
+        assert next(words) == []
+        assert next(words) == [Symbol("a")] * 30
+        enfa = intersection.to_epsilon_nfa()
+        assert enfa.accepts(["a"] * 60)
+        assert not enfa.accepts(["a"] * 10)
+        assert State((0, 0, 0)) in enfa.start_states
+        assert len(enfa.states) == 30
+
+    def test_same_as_get_intersection(self):
+        enfa0 = Regex("(a|b c)* d").to_epsilon_nfa()
+        enfa1 = Regex("a (b|c)* d|a* d").to_epsilon_nfa()
+        product = enfa0.get_intersection(enfa1)
+        intersection = enfa0.get_lazy_intersection(enfa1)
+        assert intersection.to_epsilon_nfa().is_equivalent_to(product)
+        assert set(map(tuple, intersection.get_accepted_words(5))) == \
+            set(map(tuple, product.get_accepted_words(5)))
+
+    def test_no_automaton(self):
+        with pytest.raises(ValueError):
+            LazyIntersection([])
+
+
+def get_multiple_enfa(modulo):
+    """ Words on a whose length is a multiple of modulo """
+    enfa = EpsilonNFA()
+    for state in range(modulo):
+        enfa.add_transition(state, "a", (state + 1) % modulo)
+    enfa.add_start_state(0)
+    enfa.add_final_state(0)
+    return enfa
@@ -0,0 +1,85 @@
+"""
+Tests for the matchers reading words one symbol at a time
+"""
+import itertools
+
+from pyformlang.finite_automaton import EpsilonNFA, \
+    NondeterministicFiniteAutomaton, DeterministicFiniteAutomaton, Symbol, \
+    Epsilon
+from pyformlang.regular_expression import Regex
+
+
+class TestMatcher:
+    """ Tests for the matchers reading words one symbol at a time
+    """
+
+    # pylint: disable=missing-function-docstring
+
+    def test_enfa_matcher(self):
+        enfa = Regex("(a b)* c | d*").to_epsilon_nfa()
+        matcher = enfa.matcher()
+        assert matcher.is_accepting()
+        assert matcher.feed("a")
+        assert not matcher.is_accepting()
+        assert matcher.feed(Symbol("b"))
+        assert matcher.feed(Epsilon())
+        assert matcher.feed("c")
+        assert matcher.is_accepting()
+        assert not matcher.feed("c")
+        assert matcher.is_dead()
+        assert not matcher.is_accepting()
+        matcher.reset()
+        assert matcher.feed_many(["d", "d"])
+        assert matcher.is_accepting()
+        assert not matcher.feed("z")
+
+    def test_agrees_with_accepts(self):
+        regex = Regex("(a|b)* a (a|b) | c c*")
+        automata = [regex.to_epsilon_nfa(),
+                    regex.to_epsilon_nfa(method="glushkov"),
+                    regex.to_dfa(),
+                    regex.to_epsilon_nfa().to_deterministic().minimize()]
+        words = [list(word) for length in range(5)
+                 for word in itertools.product("abc", repeat=length)]
+        for automaton in automata:
+            matcher = automaton.matcher()
+            for word in words:
+                matcher.reset()
+                matcher.feed_many(word)
+                assert matcher.is_accepting() == automaton.accepts(word)
+
+    def test_dead_states(self):
+        dfa = DeterministicFiniteAutomaton()
+        dfa.add_transitions([(0, "a", 1), (1, "b", 0), (0, "c", 2),
+                             (2, "c", 2)])
+        dfa.add_start_state(0)
+        dfa.add_final_state(1)
+        matcher = dfa.matcher()
+        assert not matcher.is_dead()
+        assert matcher.feed("a")
+        assert not matcher.feed("a")
+        matcher.reset()
+        assert not matcher.feed("c")
+        assert matcher.is_dead()
+
+    def test_stops_reading_when_dead(self):
+        nfa = NondeterministicFiniteAutomaton()
+        nfa.add_transitions([(0, "a", 0), (0, "a", 1), (1, "b", 2)])
+        nfa.add_start_state(0)
+        nfa.add_final_state(2)
+        matcher = nfa.matcher()
+        read = []
+
+        def stream():
+            for symbol in ["a", "b", "b", "a", "b"]:
+                read.append(symbol)
+                yield symbol
+
+        assert not matcher.feed_many(stream())
+        assert read == ["a", "b", "b"]
+        matcher.reset()
+        assert not matcher.feed("epsilon")
+        empty = EpsilonNFA().matcher()
+        assert empty.is_dead()
+        assert not empty.feed_many(stream())
+        assert len(read) == 3
@@ -143,6 +143,18 @@ class TestNondeterministicFiniteAutomaton:
         assert ["b", "f", "e", "f", "g"] in accepted_words
         assert len(accepted_words) == 5
 
+    def test_from_edge_arrays(self):
+        nfa = NondeterministicFiniteAutomaton.from_edge_arrays(
+            [0, 0], ["a", "a"], [1, 2], start_states=[0], final_states=[2])
+        assert isinstance(nfa, NondeterministicFiniteAutomaton)
+        assert not nfa.is_deterministic()
+        assert nfa.accepts(["a"])
+        with pytest.raises(InvalidEpsilonTransition):
+            nfa.add_transitions([(1, "a", 2), (2, Epsilon(), 0)])
+        with pytest.raises(InvalidEpsilonTransition):
+            NondeterministicFiniteAutomaton.from_edge_arrays(
+                [0], ["epsilon"], [1])
+
     def test_final_state_at_start_generation(self):
         nfa = get_nfa_example_with_final_state_at_start()
         accepted_words = list(nfa.get_accepted_words())
@@ -107,3 +107,30 @@ class TestNondeterministicTransitionFunction:
         assert (symbol_c, states[3]) in transitions
         assert (epsilon, states[4]) in transitions
         assert len(transitions) == 4
+
+    def test_get_transitions_to(self):
+        """ Tests the incoming transitions and the outgoing symbols """
+        transition_function = NondeterministicTransitionFunction()
+        states = [State(x) for x in range(0, 3)]
+        symbol_a = Symbol("a")
+        symbol_b = Symbol("b")
+        epsilon = Epsilon()
+        transition_function.add_transition(states[0], symbol_a, states[2])
+        transition_function.add_transition(states[1], symbol_a, states[2])
+        transition_function.add_transition(states[1], epsilon, states[2])
+        transition_function.add_transition(states[2], symbol_b, states[0])
+        transitions = set(transition_function.get_transitions_to(states[2]))
+        assert transitions == {(symbol_a, states[0]),
+                               (symbol_a, states[1]),
+                               (epsilon, states[1])}
+        assert set(transition_function.get_symbols_from(states[1])) == \
+            {symbol_a, epsilon}
+        assert not list(transition_function.get_transitions_to(states[1]))
+        transition_function.remove_transition(states[1], epsilon, states[2])
+        assert set(transition_function.get_symbols_from(states[1])) == \
+            {symbol_a}
+        transition_function.remove_transition(states[0], symbol_a, states[2])
+        assert set(transition_function.get_transitions_to(states[2])) == \
+            {(symbol_a, states[1])}
+        assert not transition_function.get_symbols_from(states[0])
+        assert not transition_function.get_symbols_from(State(5))
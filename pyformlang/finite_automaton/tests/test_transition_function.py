@@ -106,3 +106,30 @@ class TestTransitionFunction:
         assert (symbol_c, states[2]) in transitions
         assert (symbol_d, states[3]) in transitions
         assert len(transitions) == 3
+
+    def test_get_transitions_to(self):
+        """ Tests the incoming transitions and the outgoing symbols """
+        transition_function = TransitionFunction()
+        states = [State(x) for x in range(0, 3)]
+        symbol_a = Symbol("a")
+        symbol_b = Symbol("b")
+        transition_function.add_transition(states[0], symbol_a, states[2])
+        transition_function.add_transition(states[1], symbol_a, states[2])
+        transition_function.add_transition(states[1], symbol_b, states[2])
+        transition_function.add_transition(states[1], symbol_b, states[2])
+        transitions = set(transition_function.get_transitions_to(states[2]))
+        assert transitions == {(symbol_a, states[0]),
+                               (symbol_a, states[1]),
+                               (symbol_b, states[1])}
+        assert set(transition_function.get_symbols_from(states[1])) == \
+            {symbol_a, symbol_b}
+        with pytest.raises(DuplicateTransitionError):
+            transition_function.add_transition(states[0], symbol_a,
+                                               states[1])
+        assert not list(transition_function.get_transitions_to(states[1]))
+        transition_function.remove_transition(states[1], symbol_a, states[2])
+        assert set(transition_function.get_transitions_to(states[2])) == \
+            {(symbol_a, states[0]), (symbol_b, states[1])}
+        assert set(transition_function.get_symbols_from(states[1])) == \
+            {symbol_b}
+        assert not transition_function.get_symbols_from(State(5))
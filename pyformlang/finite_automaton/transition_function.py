@@ -2,7 +2,7 @@
 Representation of a transition function
 """
 import copy
-from typing import List, Iterable, Tuple, Any
+from typing import List, Iterable, Tuple, Any, Dict, Set
 
 from pyformlang.finite_automaton.epsilon import Epsilon
 
@@ -10,6 +10,38 @@ from .state import State
 from .symbol import Symbol
 
 
+def add_to_index(index: Dict[Any, Dict[Any, Set[Any]]], key: Any,
+                 symb_by: Any, value: Any):
+    """ Adds a value to a two-level index of sets, by key then symbol """
+    by_symbol = index.get(key)
+    if by_symbol is None:
+        by_symbol = index[key] = {}
+    values = by_symbol.get(symb_by)
+    if values is None:
+        by_symbol[symb_by] = {value}
+    else:
+        values.add(value)
+
+
+def remove_from_index(index: Dict[Any, Dict[Any, Set[Any]]], key: Any,
+                      symb_by: Any, value: Any):
+    """ Removes a value from a two-level index of sets, dropping the empty \
+    sets """
+    values = index[key][symb_by]
+    values.remove(value)
+    if not values:
+        del index[key][symb_by]
+
+
+def get_from_index(index: Dict[Any, Dict[Any, Set[Any]]], key: Any) \
+        -> Iterable[Tuple[Any, Any]]:
+    """ Gives the pairs of symbol and value stored for a key """
+    if key in index:
+        for symb_by, values in index[key].items():
+            for value in values:
+                yield symb_by, value
+
+
 class InvalidEpsilonTransition(Exception):
     """Exception raised when an epsilon transition is created in
     deterministic automaton"""
@@ -24,6 +56,9 @@ class TransitionFunction:
     ----------
     _transitions : dict
         A dictionary which contains the transitions of a finite automaton
+    _incoming : dict
+        The same transitions indexed by their destination, then by their \
+        symbol, giving the set of source states
 
     Examples
     --------
@@ -37,6 +72,7 @@ class TransitionFunction:
 
     def __init__(self):
         self._transitions = {}
+        self._incoming = {}
 
     def add_transition(self, s_from: Any, symb_by: Any,
                        s_to: Any) -> int:
@@ -79,13 +115,60 @@ class TransitionFunction:
                                                    s_to,
                                                    self._transitions[s_from][
                                                        symb_by])
-            else:
-                self._transitions[s_from][symb_by] = s_to
+                return 1
+            self._transitions[s_from][symb_by] = s_to
         else:
             self._transitions[s_from] = {}
             self._transitions[s_from][symb_by] = s_to
+        add_to_index(self._incoming, s_to, symb_by, s_from)
         return 1
 
+    def add_transitions(self,
+                        transitions: Iterable[Tuple[State, Symbol, State]]):
+        """ Adds several transitions at once
+
+        Parameters
+        ----------
+        transitions : iterable of (:class:`~pyformlang.finite_automaton\
+        .State`, :class:`~pyformlang.finite_automaton.Symbol`, \
+        :class:`~pyformlang.finite_automaton.State`)
+            The transitions to add
+
+        Raises
+        --------
+        DuplicateTransitionError
+            If a transition goes to another state than an existing one. The \
+            transitions before it are added.
+        InvalidEpsilonTransition
+            If a transition is an epsilon transition
+
+        Examples
+        --------
+
+        >>> transition = TransitionFunction()
+        >>> transition.add_transitions([(State(0), Symbol("a"), State(1)), \
+        (State(1), Symbol("a"), State(1))])
+        >>> transition.get_number_transitions()
+        2
+
+        """
+        outgoing = self._transitions
+        incoming = self._incoming
+        for s_from, symb_by, s_to in transitions:
+            if isinstance(symb_by, Epsilon):
+                raise InvalidEpsilonTransition()
+            by_symbol = outgoing.get(s_from)
+            if by_symbol is None:
+                by_symbol = outgoing[s_from] = {}
+            s_to_old = by_symbol.get(symb_by)
+            if s_to_old is not None:
+                if s_to_old != s_to:
+                    raise DuplicateTransitionError(s_from, symb_by, s_to,
+                                                   s_to_old)
+                continue
+            by_symbol[symb_by] = s_to
+            add_to_index(incoming, s_to, symb_by, s_from)
+
     # pylint: disable=duplicate-code
     def remove_transition(self, s_from: State, symb_by: Symbol,
                           s_to: State) -> int:
@@ -118,6 +201,7 @@ class TransitionFunction:
                 symb_by in self._transitions[s_from] and \
                 s_to == self._transitions[s_from][symb_by]:
             del self._transitions[s_from][symb_by]
+            remove_from_index(self._incoming, s_to, symb_by, s_from)
             return 1
         return 0
 
@@ -205,6 +289,36 @@ class TransitionFunction:
         if state_from in self._transitions:
             yield from self._transitions[state_from].items()
 
+    def get_symbols_from(self, state_from: State) -> Iterable[Symbol]:
+        """ Gets the symbols of the transitions leaving a state
+
+        Parameters
+        ----------
+        state_from : :class:`~pyformlang.finite_automaton.State`
+            The source state
+
+        Returns
+        ----------
+        symbols : iterable of :class:`~pyformlang.finite_automaton.Symbol`
+            A view on the symbols having a transition from the state
+
+        Examples
+        --------
+
+        >>> transition = TransitionFunction()
+        >>> transition.add_transition(State(0), Symbol("a"), State(1))
+        >>> list(transition.get_symbols_from(State(0)))
+        [a]
+
+        """
+        return self._transitions.get(state_from, {}).keys()
+
+    def get_transitions_to(self, state_to: State) \
+            -> Iterable[Tuple[Symbol, State]]:
+        """ Gets transitions to the given state, as pairs of symbol and \
+        source state """
+        yield from get_from_index(self._incoming, state_to)
+
 
 class DuplicateTransitionError(Exception):
     """ Signals a duplicated transition
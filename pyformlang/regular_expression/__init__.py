@@ -14,6 +14,8 @@ Available Classes
     A regular expression
 :class:`~pyformlang.regular_expression.PythonRegex`
     A regular expression closer to Python format
+:class:`~pyformlang.regular_expression.RegexSet`
+    A set of regular expressions matched together
 :class:`~pyformlang.regular_expression.MisformedRegexError`
     An error occurring when the input regex is incorrect
 
@@ -23,5 +25,6 @@ Available Classes
 from .regex import Regex
 from .regex_objects import MisformedRegexError
 from .python_regex import PythonRegex
+from .regex_set import RegexSet
 
-__all__ = ["Regex", "PythonRegex", "MisformedRegexError"]
+__all__ = ["Regex", "PythonRegex", "RegexSet", "MisformedRegexError"]
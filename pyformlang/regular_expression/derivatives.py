@@ -0,0 +1,415 @@
+"""
+Brzozowski derivatives of regular expressions, to match words and to build \
+deterministic automata without going through an epsilon NFA
+"""
+
+from typing import Dict, Iterable, Any, Tuple, List, Optional
+
+from pyformlang import finite_automaton
+from pyformlang.regular_expression.regex_objects import Concatenation, \
+    Union, KleeneStar, Epsilon, Empty, CharacterClass, Repetition
+
+EMPTY = "empty"
+EPSILON = "epsilon"
+SYMBOL = "symbol"
+CHARACTER_CLASS = "class"
+CONCATENATION = "concatenation"
+UNION = "union"
+STAR = "star"
+REPETITION = "repetition"
+
+
+def get_operands(regex) -> List[Any]:
+    """ The sons of a regex, where the nested concatenations or unions of \
+    a concatenation or a union are replaced by their own sons """
+    if not isinstance(regex.head, (Concatenation, Union)):
+        return regex.sons
+    operands = []
+    to_process = list(reversed(regex.sons))
+    while to_process:
+        current = to_process.pop()
+        if isinstance(current.head, type(regex.head)):
+            to_process.extend(reversed(current.sons))
+        else:
+            operands.append(current)
+    return operands
+
+
+class DerivativeTerm:
+    """ A regular expression, as a node shared by all equal expressions
+
+    For internal usage. Terms are only created by
+    :class:`~pyformlang.regular_expression.derivatives.Derivatives`, which \
+    ensures that two equal terms are the same object.
+
+    Parameters
+    ----------
+    kind : str
+        The operator, or the kind of leaf
+    sons : tuple of :class:`~pyformlang.regular_expression.derivatives\
+.DerivativeTerm`
+        The sub-expressions
+    value : any
+        The value of a symbol, or the bounds of a repetition
+    index : int
+        A unique number, giving a canonical order between terms
+    """
+
+    # pylint: disable=too-few-public-methods
+
+    __slots__ = ("kind", "sons", "value", "index", "nullable", "derivatives")
+
+    def __init__(self, kind: str, sons: Tuple["DerivativeTerm", ...],
+                 value: Any, index: int):
+        self.kind = kind
+        self.sons = sons
+        self.value = value
+        self.index = index
+        if kind in (EPSILON, STAR):
+            self.nullable = True
+        elif kind == CONCATENATION:
+            self.nullable = all(son.nullable for son in sons)
+        elif kind == UNION:
+            self.nullable = any(son.nullable for son in sons)
+        elif kind == REPETITION:
+            self.nullable = value[0] == 0
+        else:
+            self.nullable = False
+        self.derivatives: Dict[Any, "DerivativeTerm"] = {}
+
+    def __repr__(self):
+        # pylint: disable=too-many-return-statements
+        if self.kind == SYMBOL:
+            return str(self.value)
+        if self.kind == CHARACTER_CLASS:
+            return "[" + "".join(sorted(self.value)) + "]"
+        if self.kind == EPSILON:
+            return "$"
+        if self.kind == EMPTY:
+            return "(empty)"
+        if self.kind == STAR:
+            return repr(self.sons[0]) + "*"
+        if self.kind == REPETITION:
+            maximum = "" if self.value[1] is None else str(self.value[1])
+            return repr(self.sons[0]) + "{" + str(self.value[0]) + "," \
+                + maximum + "}"
+        separator = "." if self.kind == CONCATENATION else "|"
+        return "(" + separator.join(repr(son) for son in self.sons) + ")"
+
+
+class Derivatives:
+    """ The Brzozowski derivatives of a regular expression
+
+    The regular expression is turned into terms built with smart \
+    constructors: the empty language absorbs concatenations, epsilon is \
+    neutral for them, concatenations are flattened and unions are flattened, \
+    sorted and without duplicates. Repetitions keep their bounds, and the \
+    derivative of a repetition decrements them, so counting does not \
+    unfold the repeated term. With hash-consing, equal terms are the \
+    same object, so the derivative of a term by a symbol is computed once. \
+    This normalization makes the set of derivatives of a regex finite.
+
+    Parameters
+    ----------
+    regex : :class:`~pyformlang.regular_expression.Regex`
+        The regular expression
+
+    Examples
+    --------
+
+    >>> derivatives = Derivatives(Regex("(a b)* c"))
+    >>> derivatives.accepts(["a", "b", "c"])
+    True
+    >>> derivatives.get_derivative(derivatives.start, "a")
+    (b.(a.b)*.c)
+
+    """
+
+    def __init__(self, regex):
+        self._terms: Dict[Tuple[Any, ...], DerivativeTerm] = {}
+        self.empty = self._get_term(EMPTY)
+        self.epsilon = self._get_term(EPSILON)
+        self.start = self._from_regex(regex)
+        self._minterms: Optional[List[List[Any]]] = None
+
+    def _get_term(self, kind: str, sons: Tuple[DerivativeTerm, ...] = (),
+                  value: Any = None) -> DerivativeTerm:
+        """ Gives the unique term with the given content """
+        key = (kind, value, tuple(son.index for son in sons))
+        term = self._terms.get(key)
+        if term is None:
+            term = DerivativeTerm(kind, sons, value, len(self._terms))
+            self._terms[key] = term
+        return term
+
+    def symbol(self, value: Any) -> DerivativeTerm:
+        """ The term of a symbol """
+        return self._get_term(SYMBOL, value=value)
+
+    def character_class(self, values: Iterable[Any]) -> DerivativeTerm:
+        """ The term of a set of symbols, any of which can be read """
+        values = frozenset(values)
+        if not values:
+            return self.empty
+        if len(values) == 1:
+            return self.symbol(next(iter(values)))
+        return self._get_term(CHARACTER_CLASS, value=values)
+
+    def concatenate(self, terms: Iterable[DerivativeTerm]) -> DerivativeTerm:
+        """ The term of a concatenation """
+        sons = []
+        for term in terms:
+            if term is self.empty:
+                return self.empty
+            if term.kind == CONCATENATION:
+                sons.extend(term.sons)
+            elif term is not self.epsilon:
+                sons.append(term)
+        if not sons:
+            return self.epsilon
+        if len(sons) == 1:
+            return sons[0]
+        return self._get_term(CONCATENATION, tuple(sons))
+
+    def union(self, terms: Iterable[DerivativeTerm]) -> DerivativeTerm:
+        """ The term of a union """
+        sons = {}
+        for term in terms:
+            if term.kind == UNION:
+                for son in term.sons:
+                    sons[son.index] = son
+            elif term is not self.empty:
+                sons[term.index] = term
+        if not sons:
+            return self.empty
+        if len(sons) == 1:
+            return next(iter(sons.values()))
+        return self._get_term(UNION,
+                              tuple(sons[index] for index in sorted(sons)))
+
+    def star(self, term: DerivativeTerm) -> DerivativeTerm:
+        """ The term of a Kleene star """
+        if term.kind == STAR:
+            return term
+        if term is self.empty or term is self.epsilon:
+            return self.epsilon
+        return self._get_term(STAR, (term,))
+
+    def repeat(self, term: DerivativeTerm, minimum: int,
+               maximum: Optional[int]) -> DerivativeTerm:
+        """ The term of a repetition between minimum and maximum times, \
+        without maximum if it is None """
+        if term.nullable:
+            # The copies of the term beyond the optional ones can be empty
+            minimum = 0
+        if maximum == 0 or term is self.epsilon:
+            return self.epsilon
+        if term is self.empty:
+            return self.epsilon if minimum == 0 else self.empty
+        if minimum == 0 and maximum is None:
+            return self.star(term)
+        if minimum == 1 and maximum == 1:
+            return term
+        return self._get_term(REPETITION, (term,), (minimum, maximum))
+
+    def _from_regex(self, regex) -> DerivativeTerm:
+        """ Turns a regex into a term, without recursion. The shared \
+        sub-expressions are converted once. """
+        converted: Dict[int, DerivativeTerm] = {}
+        to_process = [(regex, False)]
+        while to_process:
+            current, operands_done = to_process.pop()
+            if id(current) in converted:
+                continue
+            operands = get_operands(current)
+            if operands and not operands_done:
+                to_process.append((current, True))
+                to_process.extend((operand, False)
+                                  for operand in reversed(operands)
+                                  if id(operand) not in converted)
+                continue
+            head = current.head
+            terms = [converted[id(operand)] for operand in operands]
+            if isinstance(head, Concatenation):
+                term = self.concatenate(terms)
+            elif isinstance(head, Union):
+                term = self.union(terms)
+            elif isinstance(head, KleeneStar):
+                term = self.star(terms[0])
+            elif isinstance(head, Repetition):
+                term = self.repeat(terms[0], head.minimum, head.maximum)
+            elif isinstance(head, Epsilon):
+                term = self.epsilon
+            elif isinstance(head, Empty):
+                term = self.empty
+            elif current.sons:
+                raise ValueError("Unknown operator " + str(head))
+            elif isinstance(head, CharacterClass):
+                term = self.character_class(head.value)
+            else:
+                term = self.symbol(head.value)
+            converted[id(current)] = term
+        return converted[id(regex)]
+
+    def get_derivative(self, term: DerivativeTerm, value: Any) \
+            -> DerivativeTerm:
+        """ Gives the derivative of a term by a symbol, i.e. the term \
+        accepting the words w such that the term accepts the symbol \
+        followed by w
+
+        Parameters
+        ----------
+        term : :class:`~pyformlang.regular_expression.derivatives\
+.DerivativeTerm`
+            The term
+        value : any
+            The value of the symbol
+
+        Returns
+        ----------
+        derivative : :class:`~pyformlang.regular_expression.derivatives\
+.DerivativeTerm`
+            The derivative
+        """
+        derivative = term.derivatives.get(value)
+        if derivative is not None:
+            return derivative
+        if term.kind == SYMBOL:
+            derivative = self.epsilon if term.value == value else self.empty
+        elif term.kind == CHARACTER_CLASS:
+            derivative = self.epsilon if value in term.value else self.empty
+        elif term.kind == STAR:
+            derivative = self.concatenate(
+                [self.get_derivative(term.sons[0], value), term])
+        elif term.kind == REPETITION:
+            minimum, maximum = term.value
+            derivative = self.concatenate(
+                [self.get_derivative(term.sons[0], value),
+                 self.repeat(term.sons[0], max(minimum - 1, 0),
+                             None if maximum is None else maximum - 1)])
+        elif term.kind == UNION:
+            derivative = self.union(self.get_derivative(son, value)
+                                    for son in term.sons)
+        elif term.kind == CONCATENATION:
+            derivative = self._get_concatenation_derivative(term, value)
+        else:
+            derivative = self.empty
+        term.derivatives[value] = derivative
+        return derivative
+
+    def _get_concatenation_derivative(self, term: DerivativeTerm,
+                                      value: Any) -> DerivativeTerm:
+        """ Derives each son which can start the word, followed by the \
+        next sons """
+        parts = []
+        for position, son in enumerate(term.sons):
+            parts.append(self.concatenate(
+                [self.get_derivative(son, value)]
+                + list(term.sons[position + 1:])))
+            if not son.nullable:
+                break
+        return self.union(parts)
+
+    def accepts(self, word: Iterable[Any]) -> bool:
+        """ Checks whether the regex accepts a word, by deriving it by each \
+        symbol of the word
+
+        Parameters
+        ----------
+        word : iterable of any
+            The symbols, or their values. Epsilon symbols are ignored.
+
+        Returns
+        ----------
+        is_accepted : bool
+            Whether the word is accepted
+        """
+        current = self.start
+        for letter in word:
+            symbol = finite_automaton.finite_automaton.to_symbol(letter)
+            if symbol == finite_automaton.Epsilon():
+                continue
+            current = self.get_derivative(current, symbol.value)
+            if current is self.empty:
+                return False
+        return current.nullable
+
+    def get_symbols(self) -> List[Any]:
+        """ The values of the symbols appearing in the regex """
+        return [value for minterm in self.get_minterms() for value in minterm]
+
+    def get_minterms(self) -> List[List[Any]]:
+        """ Partitions the symbols appearing in the regex by the symbols \
+        and the character classes containing them
+
+        The symbols of a same minterm have the same derivatives, so only \
+        one of them needs to be derived.
+
+        Returns
+        ----------
+        minterms : list of list of any
+            The values of the symbols, grouped by minterm
+        """
+        if self._minterms is None:
+            atoms: Dict[Any, List[int]] = {}
+            seen = set()
+            to_process = [self.start]
+            while to_process:
+                current = to_process.pop()
+                if current.index in seen:
+                    continue
+                seen.add(current.index)
+                if current.kind == SYMBOL:
+                    atoms.setdefault(current.value, []).append(current.index)
+                elif current.kind == CHARACTER_CLASS:
+                    for value in current.value:
+                        atoms.setdefault(value, []).append(current.index)
+                to_process.extend(current.sons)
+            minterms: Dict[Tuple[int, ...], List[Any]] = {}
+            for value, indexes in atoms.items():
+                minterms.setdefault(tuple(sorted(indexes)), []).append(value)
+            self._minterms = list(minterms.values())
+        return self._minterms
+
+    def to_dfa(self) -> "finite_automaton.DeterministicFiniteAutomaton":
+        """ Builds the automaton of the derivatives
+
+        Each state is a derivative of the regex, numbered in the order of \
+        discovery with 0 as start state. The derivatives which are the \
+        empty language are not added, so the automaton may be partial. A \
+        state is derived once per minterm, giving the transitions of all the \
+        symbols of the minterm.
+
+        Returns
+        ----------
+        dfa : :class:`~pyformlang.finite_automaton\
+.DeterministicFiniteAutomaton`
+            A deterministic automaton accepting the language of the regex
+        """
+        minterms = [[finite_automaton.Symbol(value) for value in minterm]
+                    for minterm in self.get_minterms()]
+        names = {self.start.index: 0}
+        to_process = [self.start]
+        transitions = []
+        finals = []
+        while to_process:
+            current = to_process.pop()
+            name = names[current.index]
+            if current.nullable:
+                finals.append(name)
+            for minterm in minterms:
+                derivative = self.get_derivative(current, minterm[0].value)
+                if derivative is self.empty:
+                    continue
+                next_name = names.get(derivative.index)
+                if next_name is None:
+                    next_name = len(names)
+                    names[derivative.index] = next_name
+                    to_process.append(derivative)
+                transitions.extend((name, symbol, next_name)
+                                   for symbol in minterm)
+        return finite_automaton.DeterministicFiniteAutomaton.from_edge_arrays(
+            [transition[0] for transition in transitions],
+            [transition[1] for transition in transitions],
+            [transition[2] for transition in transitions],
+            start_states=[0], final_states=finals)
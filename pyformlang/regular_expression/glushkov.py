@@ -0,0 +1,139 @@
+"""
+The Glushkov construction, turning a regex into an automaton without epsilon \
+transitions
+"""
+
+from typing import List, Set, Tuple, Any
+
+from pyformlang import finite_automaton
+from pyformlang.regular_expression.regex_objects import Concatenation, \
+    Union, KleeneStar, Epsilon, Empty, CharacterClass, Repetition
+
+# For a sub-expression: whether it accepts the empty word, the positions
+# which can start a word and the positions which can end a word
+Summary = Tuple[bool, Set[int], Set[int]]
+
+
+def _summarize_sons(head: Any, sons: List[Summary],
+                    follows: List[Set[int]]) -> Summary:
+    """ Combines the summaries of the sons of an operator, updating the \
+    positions following each position """
+    if isinstance(head, KleeneStar):
+        _, firsts, lasts = sons[0]
+        for position in lasts:
+            follows[position].update(firsts)
+        return True, firsts, lasts
+    if isinstance(head, Repetition):
+        return _summarize_copies(head, sons, follows)
+    if isinstance(head, Union):
+        return (any(son[0] for son in sons),
+                set().union(*(son[1] for son in sons)),
+                set().union(*(son[2] for son in sons)))
+    if not isinstance(head, Concatenation):
+        raise ValueError("Unknown operator " + str(head))
+    nullable, firsts, lasts = sons[0]
+    firsts = set(firsts)
+    lasts = set(lasts)
+    for son_nullable, son_firsts, son_lasts in sons[1:]:
+        for position in lasts:
+            follows[position].update(son_firsts)
+        if nullable:
+            firsts.update(son_firsts)
+        if son_nullable:
+            lasts.update(son_lasts)
+        else:
+            lasts = set(son_lasts)
+        nullable = nullable and son_nullable
+    return nullable, firsts, lasts
+
+
+def _get_copies(regex) -> List[Any]:
+    """ The sons of a regex, a repeated son appearing once per copy """
+    if isinstance(regex.head, Repetition):
+        if regex.head.maximum is None:
+            return regex.sons * (regex.head.minimum + 1)
+        return regex.sons * regex.head.maximum
+    return regex.sons
+
+
+def _summarize_copies(head: Repetition, sons: List[Summary],
+                      follows: List[Set[int]]) -> Summary:
+    """ Combines the copies of a repeated regex: the copies after the \
+    minimum are optional, and without maximum the last copy is starred """
+    copies = []
+    for index, (nullable, firsts, lasts) in enumerate(sons):
+        if head.maximum is None and index == head.minimum:
+            for position in lasts:
+                follows[position].update(firsts)
+        copies.append((nullable or index >= head.minimum, firsts, lasts))
+    return _summarize_sons(Concatenation(), copies, follows)
+
+
+def get_glushkov_nfa(regex) \
+        -> "finite_automaton.NondeterministicFiniteAutomaton":
+    """ Builds the position automaton of a regex
+
+    Each occurrence of a symbol in the regex is a position, and becomes a \
+    state reached only by this symbol. A character class is a single \
+    position, reached by any of its characters. The state 0 is the start \
+    state. The transitions follow the positions which can be consecutive \
+    in a word, computed in a single traversal of the tree, so the automaton \
+    has no epsilon transition and one more state than the number of \
+    symbols. The symbols of a repeated regex have a position per copy.
+
+    Parameters
+    ----------
+    regex : :class:`~pyformlang.regular_expression.Regex`
+        The regex
+
+    Returns
+    ----------
+    nfa : :class:`~pyformlang.finite_automaton\
+.NondeterministicFiniteAutomaton`
+        An automaton without epsilon transitions, with integers as states, \
+        accepting the language of the regex
+    """
+    symbols = [[]]
+    follows = [set()]
+    summaries = []
+    to_process = [(regex, False)]
+    while to_process:
+        current, sons_done = to_process.pop()
+        copies = _get_copies(current)
+        if copies:
+            if sons_done:
+                sons = summaries[len(summaries) - len(copies):]
+                del summaries[len(summaries) - len(copies):]
+                summaries.append(
+                    _summarize_sons(current.head, sons, follows))
+            else:
+                to_process.append((current, True))
+                to_process.extend((son, False)
+                                  for son in reversed(copies))
+        elif isinstance(current.head, (Epsilon, Repetition)):
+            summaries.append((True, set(), set()))
+        elif isinstance(current.head, Empty):
+            summaries.append((False, set(), set()))
+        else:
+            position = len(symbols)
+            if isinstance(current.head, CharacterClass):
+                symbols.append([finite_automaton.Symbol(character)
+                                for character in current.head.value])
+            else:
+                symbols.append([finite_automaton.Symbol(current.head.value)])
+            follows.append(set())
+            summaries.append((False, {position}, {position}))
+    nullable, firsts, lasts = summaries[0]
+    follows[0] = firsts
+    nfa = finite_automaton.NondeterministicFiniteAutomaton()
+    nfa.add_transitions(
+        (position, symbol, next_position)
+        for position, next_positions in enumerate(follows)
+        for next_position in next_positions
+        for symbol in symbols[next_position])
+    nfa.add_start_state(0)
+    for position in lasts:
+        nfa.add_final_state(position)
+    if nullable:
+        nfa.add_final_state(0)
+    return nfa
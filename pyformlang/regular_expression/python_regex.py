@@ -5,11 +5,15 @@ A class to read Python format regex
 import re
 import string
 import unicodedata
+from typing import Dict, FrozenSet, Optional
 
 # pylint: disable=cyclic-import
 from pyformlang.regular_expression import regex, MisformedRegexError
+from pyformlang.regular_expression.regex_objects import Union, Symbol, \
+    CharacterClass, Epsilon, Empty
+from pyformlang.regular_expression.derivatives import get_operands
 from pyformlang.regular_expression.regex_reader import \
-    WRONG_PARENTHESIS_MESSAGE
+    WRONG_PARENTHESIS_MESSAGE, get_repetition_bounds
 
 PRINTABLES = list(string.printable)
 
@@ -65,9 +69,19 @@ class PythonRegex(regex.Regex):
     * positive closure +
     * . for all printable characters
     * ? for optional character/group
-    * Repetition of characters with {m} and {n,m}q
+    * Repetition with {m}, {n,}, {,m} and {n,m}
     * Shortcuts: \\d, \\s, \\w
 
+    The unions of single characters, such as the sets of characters and \
+    the dot, become character classes. A class is read by a single pair of \
+    states in the automata built from the regex.
+
+    A repetition is a single node of the regex, whatever its bounds, and \
+    the repeated regex is not copied in the regex itself. The bounds are \
+    counted by the derivatives when matching a word, and only the \
+    automata built from the regex have a copy of the repeated regex per \
+    repetition.
+
     Parameters
     ----------
     python_regex : Union[str, Pattern[str]]
@@ -98,6 +112,8 @@ class PythonRegex(regex.Regex):
 
     """
 
+    _with_repetitions = True
+
     def __init__(self, python_regex):
         if not isinstance(python_regex, str):
             python_regex = python_regex.pattern
@@ -113,6 +129,10 @@ class PythonRegex(regex.Regex):
         self._separate()
         self._python_regex = self._python_regex.lstrip('\b')
         super().__init__(self._python_regex)
+        grouped = _group_characters(self)
+        self.head = grouped.head
+        self.sons = grouped.sons
+        self._set_shared_sons()
 
     def _separate(self):
         regex_temp = []
@@ -300,75 +320,15 @@ class PythonRegex(regex.Regex):
                 for j in range(pos_opening, len(regex_temp)):
                     regex_temp.append(regex_temp[j])
                 regex_temp.append("*")
-        regex_temp = self._add_repetition(regex_temp)
         self._python_regex = "".join(regex_temp)
 
-    @staticmethod
-    def _is_repetition(regex_list, idx):
-        if regex_list[idx] == "{":
-            end = idx
-            for i in range(idx + 1, len(regex_list)):
-                if regex_list[i] == "}":
-                    end = i
-                    break
-            inner = "".join(regex_list[idx + 1:end])
-            if "," in inner:
-                split = inner.split(",")
-                if len(split) != 2 or not split[0].isdigit() or not split[1].isdigit():
-                    return None
-                return int(split[0]), int(split[1]), end
-            if inner.isdigit():
-                return int(inner), end
-        return None
-
-    @staticmethod
-    def _find_repeated_sequence(regex_list):
-        if regex_list[-1] != ")":
-            return [regex_list[-1]]
-        res = [")"]
-        counter = -1
-        for i in range(len(regex_list) - 2, -1, -1):
-            if regex_list[i] == "(":
-                counter += 1
-                res.append("(")
-                if counter == 0:
-                    return res[::-1]
-            elif regex_list[i] == ")":
-                counter -= 1
-                res.append(")")
-            else:
-                res.append(regex_list[i])
-        return []
-
-    def _add_repetition(self, regex_list):
-        res = []
-        idx = 0
-        while idx < len(regex_list):
-            rep = self._is_repetition(regex_list, idx)
-            if rep is None:
-                res.append(regex_list[idx])
-                idx += 1
-            elif len(rep) == 2:
-                n_rep, end = rep
-                repeated = self._find_repeated_sequence(res)
-                for _ in range(n_rep - 1):
-                    res.extend(repeated)
-                idx = end + 1
-            elif len(rep) == 3:
-                min_rep, max_rep, end = rep
-                repeated = self._find_repeated_sequence(res)
-                for _ in range(min_rep - 1):
-                    res.extend(repeated)
-                for _ in range(min_rep, max_rep):
-                    res.extend(repeated)
-                    res.append("?")
-                idx = end + 1
-        return res
-
     def _preprocess_optional(self):
         regex_temp = []
         for symbol in self._python_regex:
             if symbol == "?":
+                if self._ends_with_repetition(regex_temp):
+                    # A lazy repetition, which accepts the same words
+                    continue
                 if regex_temp[-1] == ")":
                     regex_temp[-1] = "|$)"
                 elif regex_temp[-1] == "\\":
@@ -382,6 +342,16 @@ class PythonRegex(regex.Regex):
                     regex_temp.append(symbol)
         self._python_regex = "".join(regex_temp)
 
+    @staticmethod
+    def _ends_with_repetition(regex_temp):
+        if not regex_temp or regex_temp[-1] != "}":
+            return False
+        for i in range(len(regex_temp) - 2, 0, -1):
+            if regex_temp[i] == "{":
+                return get_repetition_bounds(
+                    "".join(regex_temp[i + 1:-1])) is not None
+        return False
+
     @staticmethod
     def _should_escape_next_symbol(regex_temp):
         return regex_temp and regex_temp[-1] == "\\"
@@ -410,3 +380,57 @@ class PythonRegex(regex.Regex):
         for to_replace, replacement in SHORTCUTS.items():
             self._python_regex = self._python_regex.replace(to_replace,
                                                             replacement)
+
+
+def _get_characters(operand: regex.Regex) -> Optional[FrozenSet[str]]:
+    """ The characters read by a regex made of a single character or of a \
+    character class """
+    if isinstance(operand.head, CharacterClass):
+        return operand.head.value
+    if isinstance(operand.head, Symbol) \
+            and not isinstance(operand.head, (Epsilon, Empty)) \
+            and isinstance(operand.head.value, str) \
+            and len(operand.head.value) == 1:
+        return frozenset(operand.head.value)
+    return None
+
+
+def _group_characters(to_group: regex.Regex) -> regex.Regex:
+    """ Replaces the characters in the unions of a regex by character \
+    classes, without recursion """
+    grouped: Dict[int, regex.Regex] = {}
+    to_process = [(to_group, False)]
+    while to_process:
+        current, sons_done = to_process.pop()
+        if id(current) in grouped:
+            continue
+        operands = get_operands(current) \
+            if isinstance(current.head, Union) else current.sons
+        if not sons_done:
+            to_process.append((current, True))
+            to_process.extend((operand, False) for operand in operands
+                              if id(operand) not in grouped)
+            continue
+        sons = [grouped[id(operand)] for operand in operands]
+        if not isinstance(current.head, Union):
+            grouped[id(current)] = regex.Regex.from_node(current.head, sons)
+            continue
+        characters = set()
+        others = []
+        for son in sons:
+            son_characters = _get_characters(son)
+            if son_characters is None:
+                others.append(son)
+            else:
+                characters.update(son_characters)
+        if len(characters) == 1:
+            others.insert(0, regex.Regex.from_node(
+                Symbol(characters.pop())))
+        elif characters:
+            others.insert(0, regex.Regex.from_node(
+                CharacterClass(characters)))
+        result = others[-1]
+        for son in reversed(others[:-1]):
+            result = regex.Regex.from_node(Union(), [son, result])
+        grouped[id(current)] = result
+    return grouped[id(to_group)]
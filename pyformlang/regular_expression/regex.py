@@ -1,17 +1,23 @@
 """
 Representation of a regular expression.
 """
+import weakref
 from typing import Iterable
 
 from pyformlang import finite_automaton
 # pylint: disable=cyclic-import
-import pyformlang.regular_expression.regex_objects
+from pyformlang.regular_expression import regex_objects
 from pyformlang import cfg
 from pyformlang.finite_automaton import State
 # pylint: disable=cyclic-import
 from pyformlang.regular_expression.regex_reader import RegexReader
+from pyformlang.regular_expression.glushkov import get_glushkov_nfa
+from pyformlang.regular_expression.derivatives import Derivatives
 from pyformlang import regular_expression
 
+# The sub-expressions of the existing regexes, by head and identity of sons
+_SHARED_REGEXES = weakref.WeakValueDictionary()
+
 
 class Regex(RegexReader):
     """ 
@@ -85,13 +91,159 @@ class Regex(RegexReader):
     >>> regex_concat.to_epsilon_nfa()
     """
 
+    # pylint: disable=too-many-instance-attributes
+    # pylint: disable=attribute-defined-outside-init
+
     def __init__(self, regex):
         self.head = None
         self.sons = None
         super().__init__(regex)
         self._counter = 0
-        self._initialize_enfa()
         self._enfa = None
+        self._derivatives = None
+        self._set_shared_sons()
+
+    @classmethod
+    def from_node(cls, head: "regex_objects.Node",
+                  sons: Iterable["Regex"] = ()) -> "Regex":
+        """
+        Gives the regex with the given head and sons, without parsing.
+
+        The regexes are immutable, and equal regexes built this way are the \
+        same object, so building a regex from existing ones takes a time \
+        and a memory proportional to its number of sons.
+
+        Parameters
+        ----------
+        head : :class:`~pyformlang.regular_expression.regex_objects.Node`
+            The operator or the symbol at the root of the regex
+        sons : iterable of :class:`~pyformlang.regular_expression.Regex`
+            The sub-expressions
+
+        Returns
+        ----------
+        regex : :class:`~pyformlang.regular_expression.Regex`
+            The regex
+
+        Examples
+        --------
+
+        >>> regex = Regex.from_node(regex_objects.Union(),
+        ...                         [Regex("a"), Regex("b")])
+        >>> regex.accepts(["b"])
+        True
+        >>> regex is Regex("a") | Regex("b")
+        True
+
+        """
+        sons = [son.get_shared() for son in sons]
+        shared = _SHARED_REGEXES.get((head, tuple(map(id, sons))))
+        if shared is not None:
+            return shared
+        regex = Regex.__new__(Regex)
+        regex.head = head
+        regex.sons = sons
+        regex._counter = 0
+        regex._enfa = None
+        regex._derivatives = None
+        regex._set_cached_properties()
+        _SHARED_REGEXES[regex._key] = regex
+        regex._is_shared = True
+        return regex
+
+    def _set_shared_sons(self):
+        """ Replaces the sons by their shared versions """
+        self.sons = [son.get_shared() for son in self.sons]
+        self._set_cached_properties()
+
+    def _set_cached_properties(self):
+        """ Computes the key, the hash, the size and whether the empty \
+        word is accepted, from the ones of the sons """
+        self._is_shared = False
+        self._key = (self.head, tuple(map(id, self.sons)))
+        self._hash = hash((self.head, *map(hash, self.sons)))
+        self._n_symbols = sum(son.get_number_symbols()
+                              for son in self.sons) if self.sons else 1
+        self._n_operators = 1 + sum(son.get_number_operators()
+                                    for son in self.sons) if self.sons else 0
+        if isinstance(self.head, regex_objects.Union):
+            self._nullable = any(son.is_nullable() for son in self.sons)
+        elif isinstance(self.head, regex_objects.Concatenation):
+            self._nullable = all(son.is_nullable() for son in self.sons)
+        elif isinstance(self.head, regex_objects.Repetition):
+            self._nullable = self.head.minimum == 0 or \
+                self.sons[0].is_nullable()
+        else:
+            self._nullable = isinstance(self.head, (regex_objects.KleeneStar,
+                                                    regex_objects.Epsilon))
+
+    def __getstate__(self):
+        # The key holds the identities of the sons and the hash the ones of
+        # the nodes, which do not survive a copy, so they are computed again
+        # from the copied sons
+        state = self.__dict__.copy()
+        for name in ["_key", "_hash", "_is_shared", "_enfa", "_derivatives"]:
+            state.pop(name, None)
+        return state
+
+    def __setstate__(self, state):
+        self.__dict__.update(state)
+        self._enfa = None
+        self._derivatives = None
+        self._set_shared_sons()
+
+    def get_shared(self) -> "Regex":
+        """
+        Gives the shared regex equal to this one.
+
+        Returns
+        ----------
+        regex : :class:`~pyformlang.regular_expression.Regex`
+            The unique regex object equal to this one among the sub-\
+            expressions of the existing regexes
+
+        Examples
+        --------
+
+        >>> regex = Regex("a b")
+        >>> regex.get_shared() is Regex("(a b)*").sons[0]
+        True
+
+        """
+        if self._is_shared:
+            return self
+        shared = _SHARED_REGEXES.get(self._key)
+        if shared is None:
+            _SHARED_REGEXES[self._key] = self
+            self._is_shared = True
+            return self
+        return shared
+
+    def __eq__(self, other):
+        if not isinstance(other, Regex):
+            return False
+        return self._key == other._key
+
+    def __hash__(self):
+        return self._hash
+
+    def is_nullable(self) -> bool:
+        """
+        Whether the regex accepts the empty word.
+
+        Returns
+        ----------
+        is_nullable : bool
+            Whether the empty word is accepted
+
+        Examples
+        --------
+
+        >>> Regex("a* (b|$)").is_nullable()
+        True
+
+        """
+        return self._nullable
 
     def _initialize_enfa(self):
         self._enfa = finite_automaton.EpsilonNFA()
@@ -114,9 +266,7 @@ class Regex(RegexReader):
 
         The two symbols are "a" and "b".
         """
-        if self.sons:
-            return sum(son.get_number_symbols() for son in self.sons)
-        return 1
+        return self._n_symbols
 
     def get_number_operators(self) -> int:
         """
@@ -136,25 +286,48 @@ class Regex(RegexReader):
 
         The two operators are '|' and '*'.
         """
-        if self.sons:
-            return 1 + sum(son.get_number_operators() for son in self.sons)
-        return 0
+        return self._n_operators
 
-    def to_epsilon_nfa(self):
+    def to_epsilon_nfa(self, method: str = "thompson"):
         """
         Transforms the regular expression into an epsilon NFA.
 
+        Parameters
+        ----------
+        method : str, optional
+            The construction:
+
+            * "thompson" (default): the construction of Thompson, with \
+            epsilon transitions around each operator.
+            * "glushkov": the position automaton, with no epsilon \
+            transition and one state per symbol of the regex plus a start \
+            state. The states are integers.
+
         Returns
         ----------
         enfa : :class:`~pyformlang.finite_automaton.EpsilonNFA`
             An epsilon NFA equivalent to the regex.
 
+        Raises
+        ----------
+        ValueError
+            If the method is unknown
+
         Examples
         --------
 
         >>> regex = Regex("abc|d")
         >>> regex.to_epsilon_nfa()
+
+        >>> nfa = regex.to_epsilon_nfa(method="glushkov")
+        >>> len(nfa.states)
+        3
+
         """
+        if method == "glushkov":
+            return get_glushkov_nfa(self)
+        if method != "thompson":
+            raise ValueError("Unknown construction: " + str(method))
         self._initialize_enfa()
         s_initial = self._set_and_get_initial_state_in_enfa()
         s_final = self._set_and_get_final_state_in_enfa()
@@ -193,26 +366,49 @@ class Regex(RegexReader):
             self._process_to_enfa_when_no_son(s_from, s_to)
 
     def _process_to_enfa_when_no_son(self, s_from, s_to):
-        if isinstance(self.head,
-                      pyformlang.regular_expression.regex_objects.Epsilon):
+        if isinstance(self.head, regex_objects.Epsilon):
             self._add_epsilon_transition_in_enfa_between(s_from, s_to)
-        elif not isinstance(self.head,
-                            pyformlang.regular_expression.regex_objects.Empty):
+        elif isinstance(self.head, regex_objects.CharacterClass):
+            for character in self.head.value:
+                self._enfa.add_transition(
+                    s_from, finite_automaton.Symbol(character), s_to)
+        elif not isinstance(self.head, regex_objects.Empty):
             symbol = finite_automaton.Symbol(self.head.value)
             self._enfa.add_transition(s_from, symbol, s_to)
 
     def _process_to_enfa_when_sons(self, s_from, s_to):
-        if isinstance(
-                self.head,
-                pyformlang.regular_expression.regex_objects.Concatenation):
+        if isinstance(self.head, regex_objects.Concatenation):
             self._process_to_enfa_concatenation(s_from, s_to)
-        elif isinstance(self.head,
-                        pyformlang.regular_expression.regex_objects.Union):
+        elif isinstance(self.head, regex_objects.Union):
             self._process_to_enfa_union(s_from, s_to)
-        elif isinstance(
-                self.head,
-                pyformlang.regular_expression.regex_objects.KleeneStar):
+        elif isinstance(self.head, regex_objects.KleeneStar):
             self._process_to_enfa_kleene_star(s_from, s_to)
+        elif isinstance(self.head, regex_objects.Repetition):
+            self._process_to_enfa_repetition(s_from, s_to)
+
+    def _process_to_enfa_repetition(self, s_from, s_to):
+        """ Chains the copies of the son, the optional ones being linked to \
+        the end. Without maximum, the last copy is a Kleene star. """
+        current = s_from
+        for _ in range(self.head.minimum):
+            next_state = self._get_next_state_enfa()
+            self._process_to_enfa_son(current, next_state, 0)
+            current = next_state
+        self._add_epsilon_transition_in_enfa_between(current, s_to)
+        if self.head.maximum is None:
+            state_first = self._get_next_state_enfa()
+            state_second = self._get_next_state_enfa()
+            self._add_epsilon_transition_in_enfa_between(current, state_first)
+            self._add_epsilon_transition_in_enfa_between(state_second,
+                                                         state_first)
+            self._add_epsilon_transition_in_enfa_between(state_second, s_to)
+            self._process_to_enfa_son(state_first, state_second, 0)
+            return
+        for _ in range(self.head.maximum - self.head.minimum):
+            next_state = self._get_next_state_enfa()
+            self._process_to_enfa_son(current, next_state, 0)
+            self._add_epsilon_transition_in_enfa_between(next_state, s_to)
+            current = next_state
 
     def _process_to_enfa_kleene_star(self, s_from, s_to):
         # pylint: disable=protected-access
@@ -358,10 +554,7 @@ class Regex(RegexReader):
         >>> regex_union = regex0 or regex1
         >>> regex_union.accepts(["a", "b"])
         """
-        regex = Regex("")
-        regex.head = pyformlang.regular_expression.regex_objects.Union()
-        regex.sons = [self, other]
-        return regex
+        return Regex.from_node(regex_objects.Union(), [self, other])
 
     def __or__(self, other):
         """
@@ -430,11 +623,7 @@ class Regex(RegexReader):
         >>> regex_union.accepts(["a", "b", "c"])
         True
         """
-        regex = Regex("")
-        regex.head = \
-            pyformlang.regular_expression.regex_objects.Concatenation()
-        regex.sons = [self, other]
-        return regex
+        return Regex.from_node(regex_objects.Concatenation(), [self, other])
 
     def __add__(self, other):
         """
@@ -488,10 +677,7 @@ class Regex(RegexReader):
         >>> regex_kleene.accepts(["a", "a", "a"])
         True
         """
-        regex = Regex("")
-        regex.head = pyformlang.regular_expression.regex_objects.KleeneStar()
-        regex.sons = [self]
-        return regex
+        return Regex.from_node(regex_objects.KleeneStar(), [self])
 
     def from_string(self, regex_str: str):
         """
@@ -523,6 +709,9 @@ class Regex(RegexReader):
         """
         Check if a word matches (completely) the regex.
 
+        The word is matched with the derivatives of the regex, computed \
+        once per symbol and state, so no automaton is built.
+
         Parameters
         ----------
         word : iterable of str
@@ -543,6 +732,37 @@ class Regex(RegexReader):
         >>> regex.accepts(["abc"])
         True
         """
-        if self._enfa is None:
-            self._enfa = self.to_epsilon_nfa()
-        return self._enfa.accepts(word)
+        return self._get_derivatives().accepts(word)
+
+    def _get_derivatives(self) -> Derivatives:
+        """ The derivatives of the regex, created on the first use """
+        if self._derivatives is None:
+            self._derivatives = Derivatives(self)
+        return self._derivatives
+
+    def to_dfa(self) -> "finite_automaton.DeterministicFiniteAutomaton":
+        """
+        Transforms the regular expression into a DFA whose states are its \
+        derivatives.
+
+        The derivative of a regex by a symbol accepts the ends of the words \
+        of the regex starting with this symbol. The derivatives are \
+        normalized, so there are finitely many of them, and are often fewer \
+        than the states given by the subset construction.
+
+        Returns
+        ----------
+        dfa : :class:`~pyformlang.finite_automaton\
+.DeterministicFiniteAutomaton`
+            A DFA equivalent to the regex, with integers as states and 0 as \
+            start state. It may be partial.
+
+        Examples
+        --------
+
+        >>> regex = Regex("(a|b)* a b")
+        >>> len(regex.to_dfa().states)
+        3
+
+        """
+        return self._get_derivatives().to_dfa()
@@ -1,19 +1,57 @@
 """
 Representation of some objects used in regex.
 """
+import weakref
+from typing import Optional
+
 import pyformlang
 
 
 class Node:  # pylint: disable=too-few-public-methods
     """ Represents a node in the tree representation of a regex
 
+    The nodes are immutable and interned: creating a node with the same \
+    arguments, of the same types, as an existing one gives the existing \
+    object, so nodes can be compared and hashed by identity. A node is \
+    initialized only once, when it is first created.
+
     Parameters
     ----------
     value : str
         The value of the node
     """
 
-    def __init__(self, value):
+    _instances = weakref.WeakValueDictionary()
+
+    def __new__(cls, *args):
+        # The types tell apart the equal values, like 1, 1.0 and True
+        key = (cls,) + args + tuple(map(type, args))
+        node = Node._instances.get(key)
+        if node is None:
+            node = super().__new__(cls)
+            node._arguments = args
+            node._initialize(*args)
+            Node._instances[key] = node
+        return node
+
+    def __reduce__(self):
+        # Copies and pickles go through the constructor, so that they give
+        # back the interned node
+        return self.__class__, self._arguments
+
+    def __copy__(self):
+        return self
+
+    def __deepcopy__(self, memo):
+        return self
+
+    def __init__(self, *_arguments, **_keywords):
+        # The node is initialized in __new__, so that a node given back by
+        # the cache is never modified
+        pass
+
+    def _initialize(self, value):
+        """ Sets the fields of a new node """
         self._value = value
 
     @property
@@ -127,6 +165,33 @@ class Symbol(Node):  # pylint: disable=too-few-public-methods
         return "Symbol(" + str(self._value) + ")"
 
 
+class CharacterClass(Symbol):  # pylint: disable=too-few-public-methods
+    """ Represents a set of characters, any of which can be read
+
+    Parameters
+    ----------
+    characters : iterable of str
+        The characters of the class
+    """
+
+    def __new__(cls, characters):
+        return super().__new__(cls, frozenset(characters))
+
+    def get_str_repr(self, sons_repr):
+        return "(" + "|".join(sorted(self.value)) + ")"
+
+    def get_cfg_rules(self, current_symbol, sons):
+        """ Gets the rules for a context-free grammar to represent the \
+        operator"""
+        return [pyformlang.cfg.Production(
+            pyformlang.cfg.utils.to_variable(current_symbol),
+            [pyformlang.cfg.utils.to_terminal(character)])
+                for character in sorted(self.value)]
+
+    def __repr__(self):
+        return "CharacterClass(" + "".join(sorted(self._value)) + ")"
+
+
 class Concatenation(Operator):  # pylint: disable=too-few-public-methods
     """ Represents a concatenation
     """
@@ -139,8 +204,8 @@ class Concatenation(Operator):  # pylint: disable=too-few-public-methods
             pyformlang.cfg.utils.to_variable(current_symbol),
             [pyformlang.cfg.utils.to_variable(son) for son in sons])]
 
-    def __init__(self):
-        super().__init__("Concatenation")
+    def _initialize(self):  # pylint: disable=arguments-differ
+        super()._initialize("Concatenation")
 
 
 class Union(Operator):  # pylint: disable=too-few-public-methods
@@ -156,8 +221,8 @@ class Union(Operator):  # pylint: disable=too-few-public-methods
             [pyformlang.cfg.utils.to_variable(son)])
                 for son in sons]
 
-    def __init__(self):
-        super().__init__("Union")
+    def _initialize(self):  # pylint: disable=arguments-differ
+        super()._initialize("Union")
 
 
 class KleeneStar(Operator):  # pylint: disable=too-few-public-methods
@@ -181,8 +246,68 @@ class KleeneStar(Operator):  # pylint: disable=too-few-public-methods
                 [pyformlang.cfg.utils.to_variable(son) for son in sons])
         ]
 
-    def __init__(self):
-        super().__init__("Kleene Star")
+    def _initialize(self):  # pylint: disable=arguments-differ
+        super()._initialize("Kleene Star")
+
+
+class Repetition(Operator):  # pylint: disable=too-few-public-methods
+    """ Represents a repetition of a regex between two numbers of times
+
+    Parameters
+    ----------
+    minimum : int
+        The minimum number of repetitions
+    maximum : int, optional
+        The maximum number of repetitions, None (default) for no maximum
+    """
+
+    def __new__(cls, minimum: int, maximum: Optional[int] = None):
+        return super().__new__(cls, minimum, maximum)
+
+    def _initialize(self, minimum: int, maximum: Optional[int] = None):
+        # pylint: disable=arguments-differ,arguments-renamed
+        if minimum < 0 or (maximum is not None and maximum < minimum):
+            raise ValueError("Invalid bounds of repetition")
+        self._bounds = "{" + str(minimum) + "," + \
+            ("" if maximum is None else str(maximum)) + "}"
+        super()._initialize("Repetition" + self._bounds)
+        self._minimum = minimum
+        self._maximum = maximum
+
+    @property
+    def minimum(self) -> int:
+        """ The minimum number of repetitions """
+        return self._minimum
+
+    @property
+    def maximum(self) -> Optional[int]:
+        """ The maximum number of repetitions, None if there is none """
+        return self._maximum
+
+    def get_str_repr(self, sons_repr):
+        return "(" + ".".join(sons_repr) + ")" + self._bounds
+
+    def get_cfg_rules(self, current_symbol, sons):
+        """ Gets the rules for a context-free grammar to represent the \
+        operator. The optional repetitions are chained with new variables, \
+        so the size of the rules is linear in the bounds. """
+        son = pyformlang.cfg.utils.to_variable(sons[0])
+        optional = [pyformlang.cfg.utils.to_variable(
+            str(current_symbol) + "_" + str(i))
+            for i in range(1 if self._maximum is None
+                           else self._maximum - self._minimum)]
+        rules = [pyformlang.cfg.Production(
+            pyformlang.cfg.utils.to_variable(current_symbol),
+            [son] * self._minimum + optional[:1])]
+        for i, variable in enumerate(optional):
+            rules.append(pyformlang.cfg.Production(variable, []))
+            next_variable = variable if self._maximum is None \
+                else (optional[i + 1] if i + 1 < len(optional) else None)
+            rules.append(pyformlang.cfg.Production(
+                variable,
+                [son] + ([next_variable] if next_variable is not None
+                         else [])))
+        return rules
 
 
 class Epsilon(Symbol):  # pylint: disable=too-few-public-methods
@@ -197,24 +322,38 @@ class Epsilon(Symbol):  # pylint: disable=too-few-public-methods
             pyformlang.cfg.utils.to_variable(current_symbol),
             [])]
 
-    def __init__(self):
-        super().__init__("Epsilon")
+    def _initialize(self):  # pylint: disable=arguments-differ
+        super()._initialize("Epsilon")
 
 
 class Empty(Symbol):  # pylint: disable=too-few-public-methods
     """ Represents an empty symbol
     """
 
-    def __init__(self):
-        super().__init__("Empty")
+    def _initialize(self):  # pylint: disable=arguments-differ
+        super()._initialize("Empty")
 
     def get_cfg_rules(self, current_symbol, sons):
         return []
 
 
 class MisformedRegexError(Exception):
-    """ Error for misformed regex """
+    """ Error for misformed regex
+
+    Parameters
+    ----------
+    message : str
+        The description of the error
+    regex : str
+        The misformed regex
+    position : int, optional
+        The position of the error in the regex
+    """
 
-    def __init__(self, message: str, regex: str):
+    def __init__(self, message: str, regex: str,
+                 position: Optional[int] = None):
+        if position is not None:
+            message += " Position: " + str(position) + "."
         super().__init__(message + " Regex: " + regex)
         self._regex = regex
+        self.position = position
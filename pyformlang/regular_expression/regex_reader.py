@@ -2,179 +2,110 @@
 A class to read regex
 """
 
-import re
+from typing import List, Tuple, Iterable, Optional, Callable
 
-from pyformlang.regular_expression.regex_objects import to_node, Operator, \
-    Symbol, Concatenation, Union, \
-    KleeneStar, MisformedRegexError, SPECIAL_SYMBOLS
+from pyformlang.regular_expression.regex_objects import to_node, Node, \
+    Concatenation, Union, KleeneStar, Repetition, MisformedRegexError, \
+    SPECIAL_SYMBOLS
 
 MISFORMED_MESSAGE = "The regex is misformed here."
 
 WRONG_PARENTHESIS_MESSAGE = "Wrong parenthesis regex"
 
+EMPTY_PARENTHESIS_MESSAGE = "Nothing between the parenthesis"
+
+# The symbols which are always a token on their own, unless escaped
+SINGLE_CHARACTER_SYMBOLS = {symbol for symbol in SPECIAL_SYMBOLS
+                            if len(symbol) == 1}
+
 
 class RegexReader:
     """
     A class to parse regular expressions
+
+    The regex is read in a single pass: the tokens are pushed on a stack \
+    of groups, one per opened parenthesis, so the time is linear in the \
+    length of the regex. The unions and the concatenations associate to the \
+    right, and the Kleene star binds tighter than the concatenation, which \
+    binds tighter than the union.
+
+    When repetitions are read, a valid repetition {n}, {n,}, {,m} or {n,m} \
+    after an operand binds like the Kleene star. Otherwise the braces are \
+    symbols.
     """
     # pylint: disable=too-few-public-methods
 
+    _with_repetitions = False
+
     def __init__(self, regex: str):
-        self._current_node = None
         self.head = None
         self.sons = None
-        self._end_current_group: int = 0
-        regex = _pre_process_regex(regex)
         self._regex = regex
-        self._components = _get_regex_componants(regex)
-        self._pre_process_input_regex_componants()
-        self._setup_sons()
-        self._setup_from_regex_componants()
-
-    def _remove_useless_extreme_parenthesis_from_components(self):
-        if self._begins_with_parenthesis_components():
-            self._remove_useless_extreme_parenthesis_from_componants()
-
-    def _pre_process_input_regex_componants(self):
-        self._remove_useless_extreme_parenthesis_from_components()
-        self._compute_precedence()
-        self._remove_useless_extreme_parenthesis_from_components()
-
-    def _remove_useless_extreme_parenthesis_from_componants(
-            self):
-        if self._is_surrounded_by_parenthesis():
-            self._components = self._components[1:-1]
-            self._remove_useless_extreme_parenthesis_from_components()
-
-    def _is_surrounded_by_parenthesis(self):
-        parenthesis_depths = self._get_parenthesis_depths()
-        first_complete_closing = _find_first_complete_closing_if_possible(
-            parenthesis_depths)
-        return first_complete_closing == len(self._components) - 1
-
-    def _get_parenthesis_depths(self):
-        depths = [0]
-        for component in self._components:
-            depths.append(depths[-1] + _get_parenthesis_value(component))
-        return depths[1:]
-
-    def _begins_with_parenthesis_components(self):
-        return self._components[0] == "("
-
-    def _setup_precedence_when_not_trivial(self):
-        self._set_end_first_group_in_components()
-        if self._end_current_group == len(self._components):
-            self._current_node = None
-        else:
-            self._current_node = to_node(
-                self._components[self._end_current_group])
-
-    def _setup_precedence(self):
-        if len(self._components) <= 1:
-            self._current_node = None
-        else:
-            self._setup_precedence_when_not_trivial()
-
-    def _found_no_union(self, next_node):
-        return self._end_current_group < len(
-            self._components) and not isinstance(next_node, Union)
-
-    def _add_parenthesis_around_part_of_componants(self, index_opening,
-                                                   index_closing):
-        self._components.insert(index_opening, "(")
-        # Add 1 as something was added before
-        self._components.insert(index_closing + 1, ")")
-
-    def _compute_precedent_when_not_kleene_nor_union(self):
-        while self._found_no_union(self._current_node):
-            self._set_next_end_group_and_node()
-        if isinstance(self._current_node, Union):
-            self._add_parenthesis_around_part_of_componants(
-                0, self._end_current_group)
-
-    def _compute_precedence(self):
-        """ Add parenthesis for the first group in indicate precedence """
-        self._setup_precedence()
-        if isinstance(self._current_node, KleeneStar):
-            self._add_parenthesis_around_part_of_componants(
-                0, self._end_current_group + 1)
-            self._compute_precedence()
-        elif not isinstance(self._current_node, Union):
-            self._compute_precedent_when_not_kleene_nor_union()
-
-    def _set_next_end_group_and_node(self):
-        if isinstance(self._current_node, Operator) and not isinstance(
-                self._current_node, KleeneStar):
-            self._end_current_group += 1
-        self._set_end_first_group_in_components(self._end_current_group)
-        if self._end_current_group < len(self._components):
-            self._current_node = to_node(
-                self._components[self._end_current_group])
-
-    def _set_end_first_group_in_components(self, idx_from=0):
-        """ Gives the end of the first group """
-        if idx_from >= len(self._components):
-            self._end_current_group = idx_from
-        elif self._components[idx_from] == ")":
-            raise MisformedRegexError(WRONG_PARENTHESIS_MESSAGE,
-                                      " ".join(self._components))
-        elif self._components[idx_from] == "(":
-            parenthesis_depths = self._get_parenthesis_depths()
-            first_complete_closing = _find_first_complete_closing_if_possible(
-                parenthesis_depths, idx_from)
-            if first_complete_closing > 0:
-                self._end_current_group = first_complete_closing + 1
-            else:
-                raise MisformedRegexError(WRONG_PARENTHESIS_MESSAGE,
-                                          " ".join(self._components))
-        else:
-            self._end_current_group = 1 + idx_from
-
-    def _setup_non_trivial_regex(self):
-        self._set_end_first_group_in_components()
-        next_node = to_node(self._components[self._end_current_group])
-        if isinstance(next_node, KleeneStar):
-            self.head = next_node
-            self.sons.append(
-                self._process_sub_regex(0, self._end_current_group))
-        else:
-            begin_second_group = self._end_current_group
-            if isinstance(next_node, Symbol):
-                self.head = Concatenation()
+        parsed = self._parse(_get_tokens(regex))
+        self.head = parsed.head
+        self.sons = list(parsed.sons)
+
+    @classmethod
+    def from_node(cls, head: Node, sons: Iterable["RegexReader"] = ()) \
+            -> "RegexReader":
+        """
+        Gives the regex with the given head and sons, without parsing. For \
+        internal usage.
+
+        Parameters
+        ----------
+        head : :class:`~pyformlang.regular_expression.regex_objects.Node`
+            The operator or the symbol at the root of the regex
+        sons : iterable of :class:`~pyformlang.regular_expression\
+.RegexReader`
+            The sub-expressions
+
+        Returns
+        -------
+        regex : :class:`~pyformlang.regular_expression.RegexReader`
+            The regex
+        """
+        regex = cls.__new__(cls)
+        regex.head = head
+        regex.sons = list(sons)
+        return regex
+
+    def _parse(self, tokens: List[Tuple[str, int]]) -> "RegexReader":
+        """ Builds the tree of the regex from its tokens """
+        groups = [_Group(self.from_node, self._regex, -1)]
+        index = 0
+        while index < len(tokens):
+            token, position = tokens[index]
+            index += 1
+            group = groups[-1]
+            repetition = None
+            if token == "{" and self._with_repetitions \
+                    and not group.expects_operand():
+                repetition, index = _read_repetition(tokens, index)
+            if repetition is not None:
+                group.add_postfix(repetition, position)
+            elif token == "(":
+                groups.append(_Group(self.from_node, self._regex, position))
+            elif token == ")":
+                if len(groups) == 1:
+                    raise MisformedRegexError(WRONG_PARENTHESIS_MESSAGE,
+                                              self._regex, position)
+                groups.pop()
+                groups[-1].add_operand(group.close(position))
             else:
-                self.head = next_node
-                begin_second_group += 1
-            self.sons.append(
-                self._process_sub_regex(0, self._end_current_group))
-            self.sons.append(self._process_sub_regex(begin_second_group,
-                                                     len(self._components)))
-
-    def _setup_empty_regex(self):
-        self.head = to_node("")
-
-    def _setup_one_symbol_regex(self):
-        first_symbol = to_node(self._components[0])
-        self._check_is_valid_single_first_symbol(first_symbol)
-        self.head = first_symbol
-
-    def _setup_from_regex_componants(self):
-        if not self._components:
-            self._setup_empty_regex()
-        elif len(self._components) == 1:
-            self._setup_one_symbol_regex()
-        else:
-            self._setup_non_trivial_regex()
-
-    def _process_sub_regex(self, idx_from, idx_to):
-        sub_regex = " ".join(self._components[idx_from:idx_to])
-        return self.from_string(sub_regex)
-
-    def _check_is_valid_single_first_symbol(self, first_symbol):
-        if not isinstance(first_symbol, Symbol):
-            raise MisformedRegexError(MISFORMED_MESSAGE, self._regex)
-
-    def _setup_sons(self):
-        self.sons = []
+                node = to_node(token)
+                if isinstance(node, KleeneStar):
+                    group.add_postfix(node, position)
+                elif isinstance(node, (Union, Concatenation)):
+                    group.add_operator(node, position)
+                else:
+                    group.add_operand(self.from_node(node))
+        if len(groups) > 1:
+            raise MisformedRegexError(WRONG_PARENTHESIS_MESSAGE, self._regex,
+                                      groups[-1].position)
+        if not tokens:
+            return self.from_node(to_node(""))
+        return groups[0].close(len(self._regex))
 
     def from_string(self, regex_str: str):
         """
@@ -192,54 +123,158 @@ class RegexReader:
         return RegexReader(regex_str)
 
 
-def _find_first_complete_closing_if_possible(parenthesis_depths, index_from=0):
-    try:
-        first_complete_closing = parenthesis_depths.index(0, index_from)
-    except ValueError:
-        first_complete_closing = -2
-    return first_complete_closing
-
-
-def _get_parenthesis_value(component):
-    if component == "(":
-        return 1
-    if component == ")":
-        return -1
-    return 0
-
-
-def _pre_process_regex(regex: str) -> str:
-    regex = regex.strip(" ")
-    if regex.endswith("\\") and not regex.endswith("\\\\"):
-        regex += " "
-    regex = re.sub(r" +", " ", regex)
-    regex = re.sub(r"\\ ", "\\  ", regex)
-    if regex.endswith("  "):
-        regex = regex[:-1]
-    res = []
-    pos = 0
-    previous_is_escape = False
-    for current_c in regex:
-        if not previous_is_escape and (current_c in SPECIAL_SYMBOLS) and \
-                pos != 0 and res[-1] != " ":
-            res.append(" ")
-        res.append(current_c)
-        if not previous_is_escape and (current_c in SPECIAL_SYMBOLS) and \
-                pos != len(regex) - 1 and regex[pos + 1] != " ":
-            res.append(" ")
-        previous_is_escape = current_c == "\\" and not previous_is_escape
-        pos += 1
-    return "".join(res)
-
-
-def _get_regex_componants(regex):
-    temp = regex.split(" ")
-    for i, sub in enumerate(temp):
-        if sub.endswith("\\") and not sub.endswith("\\\\"):
-            temp[i] += " "
-    if len(temp) > 1 and not temp[-1]:
-        del temp[-1]
-    temp = list(filter(lambda x: len(x) > 0, temp))
-    if not temp:
-        temp = [""]
-    return temp
+class _Group:
+    """ The part of a regex read since an opening parenthesis
+
+    For internal usage.
+
+    Parameters
+    ----------
+    from_node : callable
+        Builds a regex from a head and sons
+    regex : str
+        The regex being read, for the errors
+    position : int
+        The position of the opening parenthesis, -1 for the whole regex
+    """
+
+    def __init__(self, from_node: Callable[..., RegexReader], regex: str,
+                 position: int):
+        self._from_node = from_node
+        self._regex = regex
+        self.position = position
+        # The finished sons of the unions, and the sons of the current
+        # concatenation
+        self._alternatives: List[RegexReader] = []
+        self._operands: List[RegexReader] = []
+        # The last operator, while it has no right operand
+        self._pending: Optional[Node] = None
+
+    def expects_operand(self) -> bool:
+        """ Whether an operand is needed before a postfix or an operator """
+        return self._pending is not None or not self._operands
+
+    def add_operand(self, operand: RegexReader):
+        """ Adds an operand, concatenated to the previous ones """
+        self._operands.append(operand)
+        self._pending = None
+
+    def add_postfix(self, node: Node, position: int):
+        """ Applies the Kleene star or a repetition to the last operand """
+        if self.expects_operand():
+            raise MisformedRegexError(MISFORMED_MESSAGE, self._regex,
+                                      position)
+        self._operands[-1] = self._from_node(node, [self._operands[-1]])
+
+    def add_operator(self, node: Node, position: int):
+        """ Adds a union or an explicit concatenation """
+        if self.expects_operand():
+            raise MisformedRegexError(MISFORMED_MESSAGE, self._regex,
+                                      position)
+        if isinstance(node, Union):
+            self._alternatives.append(self._combine(self._operands,
+                                                    Concatenation()))
+            self._operands = []
+        self._pending = node
+
+    def close(self, position: int) -> RegexReader:
+        """ Gives the regex of the group. A missing right operand is the \
+        empty regex. """
+        if self._pending is not None:
+            self._operands.append(self._from_node(to_node("")))
+        elif not self._operands:
+            raise MisformedRegexError(EMPTY_PARENTHESIS_MESSAGE, self._regex,
+                                      position)
+        self._alternatives.append(self._combine(self._operands,
+                                                Concatenation()))
+        return self._combine(self._alternatives, Union())
+
+    def _combine(self, sons: List[RegexReader], head: Node) -> RegexReader:
+        """ Combines sons with a binary operator, from the right """
+        combined = sons[-1]
+        for son in reversed(sons[:-1]):
+            combined = self._from_node(head, [son, combined])
+        return combined
+
+
+def get_repetition_bounds(text: str) -> Optional[Tuple[int, Optional[int]]]:
+    """ Reads the bounds between the braces of a repetition
+
+    Parameters
+    ----------
+    text : str
+        What is between the braces, such as "2", "2,", ",5" or "2,5"
+
+    Returns
+    ----------
+    bounds : tuple of int and optional int, or None
+        The minimum and the maximum, None if there is no maximum, or None if \
+        the text is not a repetition
+    """
+    parts = text.split(",")
+    if len(parts) == 1 and parts[0].isdigit():
+        return int(parts[0]), int(parts[0])
+    if len(parts) != 2 or not any(parts) \
+            or not all(part.isdigit() for part in parts if part):
+        return None
+    minimum = int(parts[0]) if parts[0] else 0
+    maximum = int(parts[1]) if parts[1] else None
+    if maximum is not None and maximum < minimum:
+        return None
+    return minimum, maximum
+
+
+def _read_repetition(tokens: List[Tuple[str, int]], index: int) \
+        -> Tuple[Optional[Repetition], int]:
+    """ Reads a repetition whose opening brace is just before the index, \
+    giving it and the index after its closing brace, or None and the \
+    unchanged index if there is none """
+    end = index
+    while end < len(tokens) and tokens[end][0] != "}":
+        if tokens[end][0].strip("0123456789,"):
+            return None, index
+        end += 1
+    if end == len(tokens):
+        return None, index
+    bounds = get_repetition_bounds("".join(token for token, _
+                                           in tokens[index:end]))
+    if bounds is None:
+        return None, index
+    return Repetition(*bounds), end + 1
+
+
+def _get_tokens(regex: str) -> List[Tuple[str, int]]:
+    """ Splits a regex into its tokens, with their positions
+
+    The tokens are separated by spaces, and the special symbols are tokens \
+    on their own. A backslash escapes the next character. An escaped space \
+    ends a token, and a backslash at the end escapes a space.
+    """
+    tokens = []
+    current = []
+    start = 0
+    is_escaped = False
+    for position, character in enumerate(regex):
+        if is_escaped:
+            current.append(character)
+            is_escaped = False
+            if character == " ":
+                tokens.append(("".join(current), start))
+                current = []
+            continue
+        if character == " " or character in SINGLE_CHARACTER_SYMBOLS:
+            if current:
+                tokens.append(("".join(current), start))
+                current = []
+            if character != " ":
+                tokens.append((character, position))
+            continue
+        if not current:
+            start = position
+        current.append(character)
+        is_escaped = character == "\\"
+    if is_escaped:
+        current.append(" ")
+    if current:
+        tokens.append(("".join(current), start))
+    return tokens
@@ -0,0 +1,145 @@
+"""
+A set of regular expressions matched together
+"""
+
+from typing import Iterable, Any, Dict, List, FrozenSet, Union
+
+from pyformlang import finite_automaton
+from pyformlang.regular_expression.regex import Regex
+
+
+class RegexSet:
+    """ A set of regular expressions, matched in a single pass over a word
+
+    The position automata of the regexes are put side by side in a single \
+    automaton, whose states are tagged with the index of their regex. This \
+    automaton is determinized lazily while reading words, so the \
+    transitions are only computed for the sets of states actually met, \
+    once. The indexes of the regexes matching a word are read from the \
+    final states of the last set of states, and are cached for each set.
+
+    The regex set does not follow later modifications of the regexes.
+
+    Parameters
+    ----------
+    regexes : iterable of :class:`~pyformlang.regular_expression.Regex` or \
+    str
+        The regexes, as Regex or as strings to parse. A regex is identified \
+        by its index in this iterable
+    max_cache_size : int, optional
+        The maximal number of states of the lazy deterministic automaton \
+        kept in the cache, and of sets of matches, unbounded by default
+
+    Examples
+    --------
+
+    >>> regex_set = RegexSet(["a* b", "a b*", Regex("(a|b)*")])
+    >>> regex_set.get_matches(["a", "b"])
+    frozenset({0, 1, 2})
+    >>> regex_set.get_matches(["b", "b"])
+    frozenset({2})
+    >>> regex_set.accepts(["c"])
+    False
+
+    """
+
+    def __init__(self, regexes: Iterable[Union[Regex, str]],
+                 max_cache_size: int = None):
+        self._regexes = [Regex(regex) if isinstance(regex, str) else regex
+                         for regex in regexes]
+        self._enfa = finite_automaton.EpsilonNFA()
+        for index, regex in enumerate(self._regexes):
+            nfa = regex.to_epsilon_nfa(method="glushkov")
+            self._enfa.add_transitions(
+                ((index, s_from.value), symbol, (index, s_to.value))
+                for s_from, symbol, s_to in nfa)
+            for state in nfa.start_states:
+                self._enfa.add_start_state((index, state.value))
+            for state in nfa.final_states:
+                self._enfa.add_final_state((index, state.value))
+        self._lazy_dfa = finite_automaton.LazyDFA(self._enfa,
+                                                  max_cache_size)
+        self._max_cache_size = max_cache_size
+        self._matches: Dict[int, FrozenSet[int]] = {}
+
+    def __len__(self):
+        """ The number of regexes """
+        return len(self._regexes)
+
+    @property
+    def regexes(self) -> List[Regex]:
+        """ The regexes, by index """
+        return list(self._regexes)
+
+    def get_matches_of_state(self, state: int) -> FrozenSet[int]:
+        """ Gives the indexes of the regexes accepting the words leading to \
+        a state of the lazy deterministic automaton
+
+        Parameters
+        ----------
+        state : int
+            A state of the lazy automaton, as a bitset
+
+        Returns
+        ----------
+        matches : frozenset of int
+            The indexes of the regexes
+        """
+        matches = self._matches.get(state)
+        if matches is None:
+            if self._lazy_dfa.is_final(state):
+                final_states = self._enfa.final_states
+                matches = frozenset(
+                    nfa_state.value[0]
+                    for nfa_state in self._lazy_dfa.get_states(state)
+                    if nfa_state in final_states)
+            else:
+                matches = frozenset()
+            # Flushed like the cache of the lazy automaton
+            if self._max_cache_size is not None \
+                    and len(self._matches) >= self._max_cache_size:
+                self._matches = {}
+            self._matches[state] = matches
+        return matches
+
+    def get_matches(self, word: Iterable[Any]) -> FrozenSet[int]:
+        """ Gives the regexes accepting a word, reading the word once
+
+        Parameters
+        ----------
+        word : iterable of any
+            A sequence of symbols, or of their values. Epsilon symbols are \
+            ignored
+
+        Returns
+        ----------
+        matches : frozenset of int
+            The indexes of the regexes accepting the word
+        """
+        lazy_dfa = self._lazy_dfa
+        current = lazy_dfa.start_state
+        for symbol in word:
+            next_state = lazy_dfa.get_next_state(current, symbol)
+            if not next_state:
+                if finite_automaton.finite_automaton.to_symbol(symbol) \
+                        == finite_automaton.Epsilon():
+                    continue
+                return frozenset()
+            current = next_state
+        return self.get_matches_of_state(current)
+
+    def accepts(self, word: Iterable[Any]) -> bool:
+        """ Checks whether at least one regex accepts a word
+
+        Parameters
+        ----------
+        word : iterable of any
+            A sequence of symbols, or of their values. Epsilon symbols are \
+            ignored
+
+        Returns
+        ----------
+        is_accepted : bool
+            Whether a regex accepts the word
+        """
+        return bool(self.get_matches(word))
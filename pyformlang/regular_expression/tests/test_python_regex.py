@@ -1,9 +1,13 @@
 """
 Testing python regex parsing
 """
+import copy
+import pickle
 import re
 
 from pyformlang.regular_expression.python_regex import PythonRegex
+from pyformlang.regular_expression.regex_objects import CharacterClass, \
+    Repetition
 
 
 class TestPythonRegex:
@@ -309,6 +313,56 @@ class TestPythonRegex:
         self._test_compare(r"[a-z]{1,3}", "dpo")
         self._test_compare(r"[a-z]{1,3}", "dpoz")
 
+    def test_counted_repetition(self):
+        regex = PythonRegex("[a-z]{1,500}")
+        assert isinstance(regex.head, Repetition)
+        assert regex.get_number_symbols() == 1
+        assert regex.accepts("ab" * 250)
+        assert not regex.accepts("a" * 501)
+        assert not regex.accepts("")
+        assert len(regex.to_epsilon_nfa().states) < 1000
+        for regex_str, word in [("(ab){2,}c", "ababababc"),
+                                ("(ab){2,}c", "abc"),
+                                ("a{,3}b", "b"),
+                                ("a{,3}b", "aaaab"),
+                                ("(a|b?){2,3}c", "bc"),
+                                ("a{2,3}?b", "aab"),
+                                ("a{0}b", "b"),
+                                ("a{3,3}", "aaa")]:
+            self._test_compare(regex_str, word)
+        regex = PythonRegex("(a|bb){2,4}c")
+        enfa = regex.to_epsilon_nfa()
+        assert regex.to_dfa().is_equivalent_to(enfa)
+        assert regex.to_epsilon_nfa(method="glushkov").is_equivalent_to(enfa)
+        assert regex.to_cfg().contains("abbac")
+        assert not regex.to_cfg().contains("ac")
+
+    def test_copy_repetitions(self):
+        for regex_str in ["a{2,3}", "a{2}b+", "(ab){2,}c", "a{,3}b"]:
+            regex = PythonRegex(regex_str)
+            for copied in [copy.deepcopy(regex),
+                           pickle.loads(pickle.dumps(regex))]:
+                assert copied == regex
+                assert copied.head is regex.head
+                assert copied.to_epsilon_nfa().is_equivalent_to(
+                    regex.to_epsilon_nfa())
+        assert copy.deepcopy(Repetition(2, 3)) is Repetition(2, 3)
+        assert pickle.loads(pickle.dumps(Repetition(1))) is Repetition(1)
+        assert not pickle.loads(pickle.dumps(PythonRegex("a{2,3}"))) \
+            .accepts("a")
+
+    def test_copy_character_classes(self):
+        for regex_str in ["[ab]c", ".", "x.y"]:
+            regex = PythonRegex(regex_str)
+            for copied in [copy.deepcopy(regex),
+                           pickle.loads(pickle.dumps(regex))]:
+                assert copied == regex
+                assert copied.get_shared() is regex.get_shared()
+                assert copied.to_epsilon_nfa().is_equivalent_to(
+                    regex.to_epsilon_nfa())
+        assert copy.deepcopy(CharacterClass("ab")) is CharacterClass("ab")
+        assert pickle.loads(pickle.dumps(PythonRegex("[ab]c"))).accepts("bc")
+
     def test_error_backslash(self):
         self._test_compare(r"[a\\\\\\]]", "\\]")
         self._test_compare(r"\"([d\"\\\\]|\\\\.)*\"", '"d\\"')
@@ -330,3 +384,27 @@ class TestPythonRegex:
         self._test_compare(r".", "?")
         self._test_compare(r"a(a|b)?", "a")
         self._test_compare(r"a(a|b)\?", "ab?")
+
+    def test_character_classes(self):
+        regex = PythonRegex("[a-z]+@[a-z]+\\.(com|org)")
+        assert isinstance(regex.sons[0].head, CharacterClass)
+        assert len(regex.sons[0].head.value) == 26
+        enfa = regex.to_epsilon_nfa()
+        assert len(enfa.states) < 40
+        assert enfa.accepts("ab@cd.org")
+        assert not enfa.accepts("ab@cd.net")
+        assert regex.to_dfa().is_equivalent_to(enfa)
+        glushkov = regex.to_epsilon_nfa(method="glushkov")
+        assert len(glushkov.states) == 13
+        assert glushkov.is_equivalent_to(enfa)
+        assert regex.to_cfg().contains("a@b.com")
+        dfa = PythonRegex(".*a.....").to_epsilon_nfa().to_deterministic()
+        assert len(dfa.states) <= 65
+        assert PythonRegex("(a|b|cd)").sons[0].head \
+            == CharacterClass("ab")
+        assert PythonRegex("(a|cd)").sons[0].head.value == "a"
+        for regex_str, word in [(".*a[0-9]+\\w", "xya42_"),
+                                ("(ab|c)[^xyz]", "abx"),
+                                ("(ab|c)[^xyz]", "cw"),
+                                ("[a-c]*[b-d]", "abcd")]:
+            self._test_compare(regex_str, word)
@@ -1,7 +1,12 @@
 """
 Tests for regular expressions
 """
+import copy
+import itertools
+import pickle
+
 from pyformlang.regular_expression import Regex, MisformedRegexError, PythonRegex
+from pyformlang.regular_expression import regex_objects
 from pyformlang import finite_automaton
 import pytest
 
@@ -292,3 +297,154 @@ class TestRegex:
     def test_backslash(self):
         assert Regex("(\\\\|])").accepts("\\")
         assert Regex("(\\\\|])").accepts("]")
+
+    def test_glushkov(self):
+        for regex_str in ["", "$", "a", "a**", "(a|b)* a (c|$)",
+                          "(a b | c*)* (a | $) b", "(a|$)(b|$)(c|$)",
+                          "abc|d", "(a* b*)* a a", "a (b | (c d)*)* d"]:
+            regex = Regex(regex_str)
+            nfa = regex.to_epsilon_nfa(method="glushkov")
+            assert isinstance(nfa,
+                              finite_automaton.NondeterministicFiniteAutomaton)
+            assert len(nfa.states) <= regex.get_number_symbols() + 1
+            assert all(isinstance(state.value, int) for state in nfa.states)
+            assert nfa.is_equivalent_to(regex.to_epsilon_nfa())
+        nfa = Regex("(a b)* a").to_epsilon_nfa(method="glushkov")
+        assert nfa.accepts(["a", "b", "a"])
+        assert not nfa.accepts(["a", "b"])
+        assert not nfa.accepts([])
+        nfa = Regex("a* b").to_epsilon_nfa(method="glushkov")
+        assert nfa.is_deterministic()
+        with pytest.raises(ValueError):
+            Regex("a").to_epsilon_nfa(method="brzozowski")
+
+    def test_derivatives(self):
+        words = [list(word) for length in range(5)
+                 for word in itertools.product("abcd", repeat=length)]
+        for regex_str in ["", "$", "a", "a**", "(a|b)* a (c|$)",
+                          "(a b | c*)* (a | $) b", "(a|$)(b|$)(c|$)",
+                          "abc|d", "(a* b*)* a a", "a (b | (c d)*)* d"]:
+            regex = Regex(regex_str)
+            enfa = regex.to_epsilon_nfa()
+            dfa = regex.to_dfa()
+            assert isinstance(dfa,
+                              finite_automaton.DeterministicFiniteAutomaton)
+            assert dfa.is_equivalent_to(enfa)
+            for word in words:
+                assert regex.accepts(word) == enfa.accepts(word)
+        regex = Regex("(a|b)* a b")
+        assert len(regex.to_dfa().states) == 3
+        assert regex.accepts(["a", "epsilon", "b"])
+        assert regex.accepts(["a", "b"] * 1000)
+        assert not regex.accepts(["a", "c", "a", "b"])
+        assert len(Regex("").to_dfa().states) == 1
+        chain = Regex("a")
+        for _ in range(2000):
+            chain = chain.concatenate(Regex("a"))
+        assert chain.accepts(["a"] * 2001)
+        assert not chain.accepts(["a"] * 2000)
+        assert len(chain.to_dfa().states) == 2002
+
+    def test_sharing(self):
+        regex0 = Regex("(a b)* | c")
+        regex1 = Regex("c | (a b)*")
+        assert regex0.sons[0] is regex1.sons[1]
+        assert regex0.sons[1] is regex1.sons[0]
+        assert regex0 == Regex("((a b)*) | c")
+        assert hash(regex0) == hash(Regex("((a b)*) | c"))
+        assert regex0 != regex1
+        assert Regex("a") | Regex("b") is Regex("a") | Regex("b")
+        assert Regex("a").kleene_star() is Regex("a*").get_shared()
+        assert Regex.from_node(regex_objects.Symbol("a")) \
+            is Regex("a").get_shared()
+        assert regex_objects.Union() is regex_objects.Union()
+        assert regex_objects.Symbol("a") is regex_objects.Symbol("a")
+        assert regex_objects.Symbol("a") is not regex_objects.Symbol("b")
+        assert regex_objects.Epsilon() is not regex_objects.Symbol("Epsilon")
+        assert Regex("a* (b|$)").is_nullable()
+        assert not Regex("a* b").is_nullable()
+        assert Regex("").get_number_symbols() == 1
+        literals = [Regex("w" + str(i)) for i in range(5000)]
+        union = literals[0]
+        for literal in literals[1:]:
+            union = union | literal
+        assert union.get_number_symbols() == 5000
+        assert union.get_number_operators() == 4999
+        assert union.accepts(["w4321"])
+        assert not union.accepts(["w5000"])
+
+    def test_interned_nodes_unchanged(self):
+        one = regex_objects.Symbol(1)
+        true = regex_objects.Symbol(True)
+        real = regex_objects.Symbol(1.0)
+        assert one is not true
+        assert one is not real
+        assert true is not real
+        assert one is regex_objects.Symbol(1)
+        assert not isinstance(one.value, (bool, float))
+        assert isinstance(true.value, bool)
+        assert isinstance(real.value, float)
+        repetition = regex_objects.Repetition(2, 3)
+        assert regex_objects.Repetition(2.0, 3) is not repetition
+        assert not isinstance(repetition.minimum, float)
+        with pytest.raises(ValueError):
+            regex_objects.Repetition(3, 2)
+        assert regex_objects.Repetition(2, maximum=3).maximum == 3
+
+    def test_copy_shared(self):
+        regex = Regex("(a b)* | c")
+        copied = copy.deepcopy(Regex("c | d"))
+        assert copied.accepts(["d"])
+        for copied in [copy.copy(regex), copy.deepcopy(regex),
+                       pickle.loads(pickle.dumps(regex))]:
+            assert copied == regex
+            assert hash(copied) == hash(regex)
+            assert copied.head is regex.head
+            assert copied.get_shared() is regex.get_shared()
+            assert copied.accepts(["a", "b", "a", "b"])
+            assert copied.accepts(["c"])
+            assert not copied.accepts(["a"])
+        assert copy.deepcopy(regex_objects.Symbol("a")) \
+            is regex_objects.Symbol("a")
+        assert pickle.loads(pickle.dumps(regex_objects.Union())) \
+            is regex_objects.Union()
+
+    def test_misformed_position(self):
+        for regex_str, position in [("a||b", 2), ("(a b", 0), ("a b)", 3),
+                                    ("a (b|*)", 5), ("a ()", 3),
+                                    ("..a", 0), ("a | . b", 4)]:
+            with pytest.raises(MisformedRegexError) as error:
+                Regex(regex_str)
+            assert error.value.position == position
+            assert "Position: " + str(position) in str(error.value)
+
+    def test_long_regex(self):
+        regex = Regex(" | ".join("w" + str(i) + " (a b)*"
+                                 for i in range(5000)))
+        assert regex.get_number_symbols() == 15000
+        assert regex.head == regex_objects.Union()
+        assert regex.accepts(["w4999", "a", "b"])
+        assert not regex.accepts(["w4999", "a"])
+        assert str(Regex("a b | c d* | e")) == "((a.b)|((c.(d)*)|e))"
+        assert str(Regex("a|")) == "(a|Empty)"
+        assert str(Regex("(a.)b")) == "((a.Empty).b)"
+
+    def test_repetition(self):
+        regex = Regex.from_node(regex_objects.Repetition(2, 3),
+                                [Regex("a b")])
+        assert str(regex) == "((a.b)){2,3}"
+        assert regex.accepts(["a", "b"] * 3)
+        assert not regex.accepts(["a", "b"])
+        assert not regex.is_nullable()
+        assert regex.to_dfa().is_equivalent_to(regex.to_epsilon_nfa())
+        unbounded = Regex.from_node(regex_objects.Repetition(1),
+                                    [Regex("a|$")])
+        assert unbounded.is_nullable()
+        assert unbounded.accepts(["a"] * 10)
+        assert unbounded.to_epsilon_nfa(method="glushkov").is_equivalent_to(
+            Regex("a*").to_epsilon_nfa())
+        assert regex.to_cfg().contains(["a", "b", "a", "b"])
+        assert regex_objects.Repetition(2, 3) is regex_objects.Repetition(2, 3)
+        with pytest.raises(ValueError):
+            regex_objects.Repetition(3, 2)
+        assert Regex("a { 2 }").get_number_symbols() == 4
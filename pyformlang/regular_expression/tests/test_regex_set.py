@@ -0,0 +1,54 @@
+"""
+Tests for the sets of regular expressions
+"""
+import itertools
+
+from pyformlang.regular_expression import Regex, PythonRegex, RegexSet
+from pyformlang.finite_automaton import Symbol
+
+
+class TestRegexSet:
+    """ Tests for the sets of regular expressions
+    """
+
+    # pylint: disable=missing-function-docstring
+
+    def test_get_matches(self):
+        regex_set = RegexSet(["a* b", "a b*", Regex("(a|b)*"), "$"])
+        assert len(regex_set) == 4
+        assert regex_set.get_matches(["a", "b"]) == {0, 1, 2}
+        assert regex_set.get_matches(["b"]) == {0, 2}
+        assert regex_set.get_matches([]) == {2, 3}
+        assert regex_set.get_matches([Symbol("a"), "epsilon"]) == {1, 2}
+        assert regex_set.get_matches(["c"]) == set()
+        assert not regex_set.accepts(["a", "c"])
+        assert regex_set.accepts(["b", "a"])
+        assert RegexSet([]).get_matches(["a"]) == set()
+
+    def test_agrees_with_regexes(self):
+        regexes = [PythonRegex(regex) for regex in
+                   ["a[bc]*", "(ab)+", "a{2,3}c?", "[^a]*", "a.b", "b*"]]
+        regex_set = RegexSet(regexes, max_cache_size=5)
+        words = ["".join(word) for length in range(5)
+                 for word in itertools.product("abc", repeat=length)]
+        for word in words:
+            assert regex_set.get_matches(word) == \
+                {index for index, regex in enumerate(regexes)
+                 if regex.accepts(word)}
+
+    def test_matches_cache_bounded(self):
+        # pylint: disable=protected-access
+        regex_set = RegexSet(["(a|b)* a (a|b) (a|b) (a|b)"],
+                             max_cache_size=4)
+        for i in range(200):
+            word = ["a" if (i >> j) & 1 else "b" for j in range(8)]
+            assert regex_set.accepts(word) == (word[-4] == "a")
+            assert len(regex_set._matches) <= 4
+            assert regex_set._lazy_dfa.cache_size <= 4
+
+    def test_many_regexes(self):
+        regex_set = RegexSet(["w" + str(i) + " (a|b)* c" + str(i % 7)
+                              for i in range(1000)])
+        assert regex_set.get_matches(["w42", "a", "b", "c0"]) == {42}
+        assert regex_set.get_matches(["w42", "a", "b", "c1"]) == set()
+        assert len(regex_set.regexes) == 1000